@@ -0,0 +1,34 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CXA_CONFIG_H_
+#define CXA_CONFIG_H_
+
+
+/**
+ * @file
+ * Configuration shared by the standalone POSIX example / test programs
+ * in this directory.
+ *
+ * @author Christopher Armenio
+ */
+
+
+// ******** global macro definitions ********
+#define CXA_LINE_ENDING						"\n"
+#define CXA_ASSERT_LINE_NUM_ENABLE
+
+
+#endif // CXA_CONFIG_H_
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ * Two-thread stress test for ::cxa_fixedFifo_spsc_t. A producer thread queues
+ * a sequence of counters (mixing single, bulk and reserve/commit queues) into a
+ * deliberately small FIFO while the main thread dequeues them (mixing single,
+ * bulk-copy and peek/dequeue) and checks that every element arrives, in order.
+ * Exits with a non-zero status on failure.
+ *
+ * Build and run (from the repository root), ideally with -fsanitize=thread:
+ *
+ *     gcc -std=gnu11 -O2 -pthread -Iexamples/posix -Iinclude/collections -Iinclude/misc -Iinclude/serial \
+ *         examples/posix/fixedFifo_spsc_stress.c src/collections/cxa_fixedFifo_spsc.c -o fixedFifo_spsc_stress
+ *     ./fixedFifo_spsc_stress [numElements]
+ *
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cxa_assert.h>
+#include <cxa_fixedFifo_spsc.h>
+
+
+// ******** local macro definitions ********
+#define DEFAULT_NUM_ELEMENTS			2000000
+#define FIFO_SIZE_ELEMS					7
+#define MAX_BULK_SIZE_ELEMS				5
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static bool checkSingleThreaded(void);
+static void* producerThread(void* userVarIn);
+static uint32_t produce(uint32_t nextValIn);
+static uint32_t consume(uint32_t expectedValIn, uint32_t *const numErrorsOut);
+
+
+// ********  local variable declarations *********
+static cxa_fixedFifo_spsc_t fifo;
+static uint32_t fifo_raw[FIFO_SIZE_ELEMS];
+
+static uint32_t numElements = DEFAULT_NUM_ELEMENTS;
+
+
+// ******** global function implementations ********
+int main(int argc, char* argv[])
+{
+	if( argc > 1 ) numElements = (uint32_t)strtoul(argv[1], NULL, 0);
+
+	cxa_fixedFifo_spsc_initStd(&fifo, fifo_raw);
+	if( !checkSingleThreaded() ) return EXIT_FAILURE;
+
+	// the producer runs until all elements have been queued
+	pthread_t producer;
+	if( pthread_create(&producer, NULL, producerThread, NULL) != 0 ) return EXIT_FAILURE;
+
+	uint32_t expectedVal = 0;
+	uint32_t numErrors = 0;
+	while( expectedVal < numElements )
+	{
+		uint32_t nextExpectedVal = consume(expectedVal, &numErrors);
+		if( nextExpectedVal == expectedVal ) sched_yield();
+		expectedVal = nextExpectedVal;
+	}
+	pthread_join(producer, NULL);
+
+	if( !cxa_fixedFifo_spsc_isEmpty(&fifo) ) numErrors++;
+	printf("%" PRIu32 " elements, %" PRIu32 " errors\n", numElements, numErrors);
+	return (numErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+void cxa_assert_impl(const char *msgIn, const char *fileIn, const long int lineIn)
+{
+	fprintf(stderr, "**assert** %s:%ld %s\n", (fileIn != NULL) ? fileIn : "?", lineIn, (msgIn != NULL) ? msgIn : "");
+	abort();
+}
+
+
+// ******** local function implementations ********
+static bool checkSingleThreaded(void)
+{
+	// every element of the buffer is usable
+	uint32_t val = 0;
+	for( size_t i = 0; i < FIFO_SIZE_ELEMS; i++ )
+	{
+		if( !cxa_fixedFifo_spsc_queue(&fifo, &val) ) { printf("queue failed before full\n"); return false; }
+	}
+	if( !cxa_fixedFifo_spsc_isFull(&fifo) || cxa_fixedFifo_spsc_queue(&fifo, &val) ) { printf("queued to a full fifo\n"); return false; }
+	if( cxa_fixedFifo_spsc_getSize_elems(&fifo) != FIFO_SIZE_ELEMS ) { printf("wrong size when full\n"); return false; }
+
+	cxa_fixedFifo_spsc_clear(&fifo);
+	if( !cxa_fixedFifo_spsc_isEmpty(&fifo) || cxa_fixedFifo_spsc_dequeue(&fifo, &val) ) { printf("dequeued from an empty fifo\n"); return false; }
+
+	return true;
+}
+
+
+static void* producerThread(void* userVarIn)
+{
+	(void)userVarIn;
+
+	uint32_t nextVal = 0;
+	while( nextVal < numElements )
+	{
+		uint32_t newNextVal = produce(nextVal);
+		if( newNextVal == nextVal ) sched_yield();
+		nextVal = newNextVal;
+	}
+
+	return NULL;
+}
+
+
+static uint32_t produce(uint32_t nextValIn)
+{
+	uint32_t numRemaining = numElements - nextValIn;
+
+	switch( nextValIn % 3 )
+	{
+		case 0:
+		{
+			// bulk copy (may wrap around the end of the buffer)
+			uint32_t vals[MAX_BULK_SIZE_ELEMS];
+			size_t numVals = (numRemaining < MAX_BULK_SIZE_ELEMS) ? numRemaining : MAX_BULK_SIZE_ELEMS;
+			for( size_t i = 0; i < numVals; i++ ) vals[i] = nextValIn + (uint32_t)i;
+			return nextValIn + (uint32_t)cxa_fixedFifo_spsc_bulkQueue(&fifo, vals, numVals);
+		}
+
+		case 1:
+		{
+			// write in place
+			uint32_t* vals;
+			size_t numVals = cxa_fixedFifo_spsc_bulkQueue_reserve(&fifo, (void**)&vals);
+			if( numVals > numRemaining ) numVals = numRemaining;
+			for( size_t i = 0; i < numVals; i++ ) vals[i] = nextValIn + (uint32_t)i;
+			cxa_fixedFifo_spsc_bulkQueue_commit(&fifo, numVals);
+			return nextValIn + (uint32_t)numVals;
+		}
+
+		default:
+			return cxa_fixedFifo_spsc_queue(&fifo, &nextValIn) ? (nextValIn + 1) : nextValIn;
+	}
+}
+
+
+static uint32_t consume(uint32_t expectedValIn, uint32_t *const numErrorsOut)
+{
+	uint32_t vals[MAX_BULK_SIZE_ELEMS];
+	uint32_t* peekedVals = vals;
+	size_t numVals;
+
+	switch( expectedValIn % 3 )
+	{
+		case 0:
+			numVals = cxa_fixedFifo_spsc_bulkDequeue_copy(&fifo, vals, MAX_BULK_SIZE_ELEMS);
+			break;
+
+		case 1:
+			// parse in place, then release
+			numVals = cxa_fixedFifo_spsc_bulkDequeue_peek(&fifo, (void**)&peekedVals);
+			break;
+
+		default:
+			numVals = cxa_fixedFifo_spsc_dequeue(&fifo, vals) ? 1 : 0;
+			break;
+	}
+
+	for( size_t i = 0; i < numVals; i++ )
+	{
+		if( peekedVals[i] != expectedValIn + i )
+		{
+			if( *numErrorsOut == 0 ) printf("expected %" PRIu32 ", got %" PRIu32 "\n", expectedValIn + (uint32_t)i, peekedVals[i]);
+			(*numErrorsOut)++;
+		}
+	}
+	if( (peekedVals != vals) && !cxa_fixedFifo_spsc_bulkDequeue(&fifo, numVals) ) (*numErrorsOut)++;
+
+	return expectedValIn + (uint32_t)numVals;
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ * Benchmark comparing name lookups in a ::cxa_hashMap_t (string keys, ~75% full)
+ * against the linear scan over a ::cxa_array_t of named entries that modules
+ * (eg. rpc methods, mqtt topics, console commands) otherwise use. Reports the
+ * average time per lookup, for hits and misses, at several table sizes.
+ *
+ * Build and run (from the repository root):
+ *
+ *     gcc -std=gnu11 -O2 -Iexamples/posix -Iinclude/collections -Iinclude/misc -Iinclude/serial \
+ *         examples/posix/hashMap_benchmark.c src/collections/cxa_hashMap.c src/collections/cxa_array.c -o hashMap_benchmark
+ *     ./hashMap_benchmark [numLookups]
+ *
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <cxa_array.h>
+#include <cxa_assert.h>
+#include <cxa_hashMap.h>
+
+
+// ******** local macro definitions ********
+#define DEFAULT_NUM_LOOKUPS				2000000
+#define MAX_NUM_ENTRIES					256
+#define MAX_NAME_LEN_BYTES				23
+
+// size the map so it is (at most) ~75% full
+#define MAP_NUM_SLOTS					(((MAX_NUM_ENTRIES * 4) / 3) + 1)
+
+
+// ******** local type definitions ********
+typedef struct
+{
+	char name[MAX_NAME_LEN_BYTES+1];
+	uintptr_t handler;
+}namedEntry_t;
+
+
+// ******** local function prototypes ********
+static void runBenchmark(size_t numEntriesIn, uint32_t numLookupsIn);
+static uintptr_t array_find(cxa_array_t *const arrIn, const char *const nameIn);
+static uint64_t getTime_ns(void);
+
+
+// ********  local variable declarations *********
+static cxa_array_t array;
+static namedEntry_t array_raw[MAX_NUM_ENTRIES];
+
+static cxa_hashMap_t map;
+static _Alignas(CXA_HASHMAP_ALIGNMENT_BYTES) uint8_t map_raw[CXA_HASHMAP_BUFFER_SIZE_BYTES(MAP_NUM_SLOTS, MAX_NAME_LEN_BYTES+1, sizeof(uintptr_t))];
+
+static char hitNames[MAX_NUM_ENTRIES][MAX_NAME_LEN_BYTES+1];
+static char missNames[MAX_NUM_ENTRIES][MAX_NAME_LEN_BYTES+1];
+
+// keeps the compiler from discarding lookups
+static volatile uintptr_t sink;
+
+
+// ******** global function implementations ********
+int main(int argc, char* argv[])
+{
+	uint32_t numLookups = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : DEFAULT_NUM_LOOKUPS;
+	if( numLookups == 0 ) return EXIT_FAILURE;
+
+	// names with a common prefix, like real method / topic names
+	for( size_t i = 0; i < MAX_NUM_ENTRIES; i++ )
+	{
+		snprintf(hitNames[i], sizeof(hitNames[i]), "node/method_%zu", i);
+		snprintf(missNames[i], sizeof(missNames[i]), "node/unknown_%zu", i);
+	}
+
+	printf("%8s %14s %14s %14s %14s\n", "entries", "array hit ns", "map hit ns", "array miss ns", "map miss ns");
+	for( size_t numEntries = 4; numEntries <= MAX_NUM_ENTRIES; numEntries *= 2 ) runBenchmark(numEntries, numLookups);
+
+	return EXIT_SUCCESS;
+}
+
+
+void cxa_assert_impl(const char *msgIn, const char *fileIn, const long int lineIn)
+{
+	fprintf(stderr, "**assert** %s:%ld %s\n", (fileIn != NULL) ? fileIn : "?", lineIn, (msgIn != NULL) ? msgIn : "");
+	abort();
+}
+
+
+// ******** local function implementations ********
+static void runBenchmark(size_t numEntriesIn, uint32_t numLookupsIn)
+{
+	cxa_array_initStd(&array, array_raw);
+	cxa_hashMap_init_stringKeys(&map, MAX_NAME_LEN_BYTES, sizeof(uintptr_t), map_raw, CXA_HASHMAP_BUFFER_SIZE_BYTES(((numEntriesIn * 4) / 3) + 1, MAX_NAME_LEN_BYTES+1, sizeof(uintptr_t)), NULL, NULL);
+
+	for( size_t i = 0; i < numEntriesIn; i++ )
+	{
+		namedEntry_t newEntry = {.handler=(uintptr_t)(i+1)};
+		strcpy(newEntry.name, hitNames[i]);
+		cxa_assert(cxa_array_append(&array, &newEntry));
+		cxa_assert(cxa_hashMap_put(&map, hitNames[i], &newEntry.handler));
+	}
+
+	// make sure both containers agree before timing them
+	for( size_t i = 0; i < numEntriesIn; i++ )
+	{
+		uintptr_t* mapHandler = (uintptr_t*)cxa_hashMap_get(&map, hitNames[i]);
+		cxa_assert((mapHandler != NULL) && (*mapHandler == array_find(&array, hitNames[i])));
+		cxa_assert((cxa_hashMap_get(&map, missNames[i]) == NULL) && (array_find(&array, missNames[i]) == 0));
+	}
+
+	uint64_t startTime_ns = getTime_ns();
+	for( uint32_t i = 0; i < numLookupsIn; i++ ) sink = array_find(&array, hitNames[i % numEntriesIn]);
+	uint64_t arrayHit_ns = getTime_ns() - startTime_ns;
+
+	startTime_ns = getTime_ns();
+	for( uint32_t i = 0; i < numLookupsIn; i++ ) sink = *(uintptr_t*)cxa_hashMap_get(&map, hitNames[i % numEntriesIn]);
+	uint64_t mapHit_ns = getTime_ns() - startTime_ns;
+
+	startTime_ns = getTime_ns();
+	for( uint32_t i = 0; i < numLookupsIn; i++ ) sink = array_find(&array, missNames[i % numEntriesIn]);
+	uint64_t arrayMiss_ns = getTime_ns() - startTime_ns;
+
+	startTime_ns = getTime_ns();
+	for( uint32_t i = 0; i < numLookupsIn; i++ ) sink = (uintptr_t)cxa_hashMap_get(&map, missNames[i % numEntriesIn]);
+	uint64_t mapMiss_ns = getTime_ns() - startTime_ns;
+
+	printf("%8zu %14.1f %14.1f %14.1f %14.1f\n", numEntriesIn,
+		   (double)arrayHit_ns / numLookupsIn, (double)mapHit_ns / numLookupsIn,
+		   (double)arrayMiss_ns / numLookupsIn, (double)mapMiss_ns / numLookupsIn);
+}
+
+
+static uintptr_t array_find(cxa_array_t *const arrIn, const char *const nameIn)
+{
+	cxa_array_iterate(arrIn, currEntry, namedEntry_t)
+	{
+		if( strcmp(currEntry->name, nameIn) == 0 ) return currEntry->handler;
+	}
+
+	return 0;
+}
+
+
+static uint64_t getTime_ns(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
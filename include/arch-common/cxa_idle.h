@@ -0,0 +1,68 @@
+/**
+ * @file
+ * This file contains functions for idling (eg. entering a low-power mode) until
+ * there is something to do. It is used by the run loop when tickless idle is
+ * enabled (CXA_RUNLOOP_TICKLESS_IDLE_ENABLE) but may also be used directly.
+ *
+ * Architectures which support tickless idle implement these functions: typically
+ * by sleeping until an interrupt occurs or the requested time has elapsed.
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * // sleep until an interrupt occurs, ::cxa_idle_wake is called, or 100ms elapses
+ * cxa_idle_sleep_ms(100);
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_IDLE_H_
+#define CXA_IDLE_H_
+
+
+// ******** includes ********
+#include <stdint.h>
+
+
+// ******** global macro definitions ********
+#define CXA_IDLE_FOREVER						UINT32_MAX
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Idles until an interrupt (or signal) occurs, ::cxa_idle_wake is
+ * called, or the given time elapses. May return early.
+ *
+ * @param[in] maxSleep_msIn maximum time to idle, in milliseconds
+ * 		(or CXA_IDLE_FOREVER)
+ */
+void cxa_idle_sleep_ms(uint32_t maxSleep_msIn);
+
+
+/**
+ * @public
+ * @brief Causes any current (or, if none, the next) call to ::cxa_idle_sleep_ms
+ * to return immediately. Safe to call from any thread, interrupt or signal handler.
+ */
+void cxa_idle_wake(void);
+
+
+#endif // CXA_IDLE_H_
@@ -76,4 +76,18 @@ uint32_t cxa_timeBase_getCount_us(void);
 uint32_t cxa_timeBase_getMaxCount_us(void);
 
 
+/**
+ * @public
+ * @brief Returns the current monotonic, relative time in nanoseconds as
+ * a 64-bit value. At this range, the counter will not overflow in practice
+ * so elapsed time may be calculated with a simple subtraction.
+ *
+ * @note Only available on architectures with a 64-bit time source (currently
+ * 		POSIX). Used by ::cxa_timeDiff64_t.
+ *
+ * @return the current time of the timeBase, in nanoseconds
+ */
+uint64_t cxa_timeBase_getCount64_ns(void);
+
+
 #endif // CXA_TIMEBASE_H_
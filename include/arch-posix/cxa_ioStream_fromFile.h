@@ -31,6 +31,13 @@
 
 
 // ******** global macro definitions ********
+#ifndef CXA_IOSTREAM_FROMFILE_READBUFFER_SIZE_BYTES
+	#define CXA_IOSTREAM_FROMFILE_READBUFFER_SIZE_BYTES			4096
+#endif
+
+#ifndef CXA_IOSTREAM_FROMFILE_WRITEBUFFER_SIZE_BYTES
+	#define CXA_IOSTREAM_FROMFILE_WRITEBUFFER_SIZE_BYTES		4096
+#endif
 
 
 // ******** global type definitions *********
@@ -46,11 +53,67 @@ struct cxa_ioStream_fromFile
 	cxa_ioStream_t super;
 
 	FILE* file;
+
+	uint8_t readBuffer[CXA_IOSTREAM_FROMFILE_READBUFFER_SIZE_BYTES];
+	size_t readBuffer_startIndex;
+	size_t readBuffer_endIndex;
+
+	uint8_t writeBuffer[CXA_IOSTREAM_FROMFILE_WRITEBUFFER_SIZE_BYTES];
+	size_t writeBuffer_len;
+	bool isLineBuffered;
+
+	cxa_ioStream_fromFile_t* nextOpenStream;
 };
 
 
 // ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes an ioStream which reads from and writes to the
+ * given file.
+ *
+ * Reads are performed in blocks of up to
+ * CXA_IOSTREAM_FROMFILE_READBUFFER_SIZE_BYTES and subsequently served
+ * from memory. Writes are collected into a buffer of
+ * CXA_IOSTREAM_FROMFILE_WRITEBUFFER_SIZE_BYTES and only handed to the
+ * file when that buffer fills, when the read-ahead buffer needs to be
+ * refilled, when ::cxa_ioStream_fromFile_flush is called, or when the
+ * stream is closed. If the file is a terminal, writes are also handed to
+ * the file at the end of each line (like stdio). Any buffered data is
+ * written when the process exits (eg. following an assert).
+ *
+ * @note Every initialized stream is tracked (for the exit-time flush) until it is
+ * 		closed, so ::cxa_ioStream_fromFile_close _must_ be called before the stream's
+ * 		memory is released or reused (eg. before a stack-allocated stream goes out
+ * 		of scope).
+ *
+ * @param[in] ioStreamIn pointer to a pre-allocated ioStream object
+ * @param[in] fileIn the (already opened) file to use
+ */
 void cxa_ioStream_fromFile_init(cxa_ioStream_fromFile_t *const ioStreamIn, FILE *const fileIn);
+
+
+/**
+ * @public
+ * @brief Writes any buffered (write-behind) data to the underlying file.
+ *
+ * @param[in] ioStreamIn pointer to a pre-initialized ioStream object
+ *
+ * @return true if all buffered data was written, false if an error
+ * 		occurred (unwritten data remains buffered)
+ */
+bool cxa_ioStream_fromFile_flush(cxa_ioStream_fromFile_t *const ioStreamIn);
+
+
+/**
+ * @public
+ * @brief Flushes any buffered data and stops tracking the stream (so its
+ * memory may be released). Any unread read-ahead data is discarded.
+ *
+ * The underlying FILE is _not_ closed (it still belongs to the caller).
+ *
+ * @param[in] ioStreamIn pointer to a pre-initialized ioStream object
+ */
 void cxa_ioStream_fromFile_close(cxa_ioStream_fromFile_t *const ioStreamIn);
 
 #endif // CXA_IOSTREAM_FROMFILE_H_
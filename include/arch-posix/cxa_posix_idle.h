@@ -0,0 +1,69 @@
+/**
+ * @file
+ * This file contains POSIX-specific additions to the idle functionality (see
+ * @ref cxa_idle.h).
+ *
+ * ::cxa_idle_sleep_ms atomically installs a 'sleep' signal mask while it waits
+ * (using ppoll on Linux, pselect elsewhere), so a signal which is blocked while the thread is running can
+ * still interrupt the sleep, without the race of a signal arriving just before
+ * the thread goes to sleep. By default, the sleep mask is the thread's signal
+ * mask at the time of its first sleep (ie. nothing changes while sleeping).
+ *
+ * @note This file contains functionality in addition to that already provided in @ref cxa_idle.h
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * // SIGINT is only delivered while idling (so handlers don't interrupt entries)
+ * sigset_t blocked, sleepMask;
+ * sigemptyset(&blocked);
+ * sigaddset(&blocked, SIGINT);
+ * pthread_sigmask(SIG_BLOCK, &blocked, &sleepMask);
+ * cxa_posix_idle_setSleepSigmask(&sleepMask);
+ *
+ * cxa_runLoop_execute();
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_IDLE_H_
+#define CXA_POSIX_IDLE_H_
+
+
+// ******** includes ********
+#include <signal.h>
+#include <cxa_idle.h>
+
+
+// ******** global macro definitions ********
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Sets the signal mask which is installed (for the calling thread)
+ * while it is sleeping in ::cxa_idle_sleep_ms.
+ *
+ * @param[in] maskIn the signal mask to use while sleeping
+ */
+void cxa_posix_idle_setSleepSigmask(const sigset_t *const maskIn);
+
+
+#endif // CXA_POSIX_IDLE_H_
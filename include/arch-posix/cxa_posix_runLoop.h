@@ -0,0 +1,261 @@
+/**
+ * @file
+ * This file contains an event-driven (epoll-backed) run loop for Linux.
+ *
+ * Instead of calling every callback on every iteration, callbacks register
+ * 'sources' which are only called when one of their file descriptors is
+ * ready or their deadline expires. While nothing is ready, the process
+ * sleeps in epoll_wait.
+ *
+ * Entries registered with ::cxa_runLoop_addEntry are still called once per
+ * iteration. Since they must be polled, the loop will _not_ sleep while any
+ * such entries are registered. Entries registered with ::cxa_runLoop_addEntry_eventDriven
+ * do not keep the loop awake unless they signal more work (see ::cxa_runLoop_signalMoreWork).
+ * Timers (see ::cxa_timer_t) are serviced without polling: the loop sleeps until
+ * the next one is due.
+ *
+ * The event-driven loop wraps the default run loop (see ::cxa_runLoop_getDefault).
+ * Additional run loops (eg. one per thread) each get their own epoll set: sources
+ * are bound to them using ::cxa_posix_runLoop_source_init_withRunLoop and they are
+ * iterated with ::cxa_posix_runLoop_instance_execute (from their own thread).
+ *
+ * When CXA_RUNLOOP_POST_ENABLE is defined, work posted to a run loop
+ * (see ::cxa_runLoop_post) wakes the loop immediately via an eventfd.
+ *
+ * @note This file contains functionality restricted to the CXA POSIX (Linux) implementation.
+ * 		It is only available when __linux__ is defined.
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * static void onEvent(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn)
+ * {
+ *    if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_READABLE ) { ...read from the fd... }
+ *    if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_DEADLINE ) { ...handle the timeout... }
+ * }
+ *
+ * cxa_posix_runLoop_source_t mySource;
+ * cxa_posix_runLoop_source_init(&mySource, onEvent, NULL);
+ * cxa_posix_runLoop_source_watchFd(&mySource, myFd, CXA_POSIX_RUNLOOP_EVENT_READABLE);
+ * cxa_posix_runLoop_source_setDeadline_ms(&mySource, 1000);
+ *
+ * cxa_posix_runLoop_execute();
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_POSIX_RUNLOOP_H_
+#define CXA_POSIX_RUNLOOP_H_
+#ifdef __linux__
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stdint.h>
+#include <cxa_runLoop.h>
+#include <cxa_timer.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_POSIX_RUNLOOP_MAXNUM_SOURCES
+	#define CXA_POSIX_RUNLOOP_MAXNUM_SOURCES				16
+#endif
+
+#ifndef CXA_POSIX_RUNLOOP_MAXNUM_RUNLOOPS
+	#define CXA_POSIX_RUNLOOP_MAXNUM_RUNLOOPS				4
+#endif
+
+#define CXA_POSIX_RUNLOOP_EVENT_READABLE					(1 << 0)
+#define CXA_POSIX_RUNLOOP_EVENT_WRITABLE					(1 << 1)
+#define CXA_POSIX_RUNLOOP_EVENT_ERROR						(1 << 2)
+#define CXA_POSIX_RUNLOOP_EVENT_DEADLINE					(1 << 3)
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_posix_runLoop_source_t object
+ */
+typedef struct cxa_posix_runLoop_source cxa_posix_runLoop_source_t;
+
+
+/**
+ * @public
+ * @brief Called when a source has work to do
+ *
+ * @param[in] srcIn the source which is ready
+ * @param[in] eventsIn bitmask of CXA_POSIX_RUNLOOP_EVENT_* describing why
+ * 		the source was called
+ * @param[in] userVarIn the user variable passed to ::cxa_posix_runLoop_source_init
+ */
+typedef void (*cxa_posix_runLoop_cb_onEvent_t)(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn);
+
+
+/**
+ * @private
+ */
+struct cxa_posix_runLoop_context;
+
+
+/**
+ * @private
+ */
+struct cxa_posix_runLoop_source
+{
+	struct cxa_posix_runLoop_context* context;
+
+	int fd;
+	uint32_t watchedEvents;
+
+	cxa_timer_t timer_deadline;
+
+	cxa_posix_runLoop_cb_onEvent_t cb;
+	void* userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes a source and registers it with the run loop. The
+ * source will not be called until it is watching a file descriptor or
+ * has a deadline.
+ *
+ * @param[in] srcIn pointer to a pre-allocated source
+ * @param[in] cbIn callback to be called when the source is ready
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_posix_runLoop_source_init(cxa_posix_runLoop_source_t *const srcIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Same as ::cxa_posix_runLoop_source_init, but registers the source
+ * with the given run loop (rather than the default run loop). The source
+ * is only called from ::cxa_posix_runLoop_instance_iterate for that run loop.
+ *
+ * @param[in] rlIn the run loop which will call this source
+ */
+void cxa_posix_runLoop_source_init_withRunLoop(cxa_posix_runLoop_source_t *const srcIn, cxa_runLoop_t *const rlIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Unregisters a source from the run loop (stops watching its
+ * file descriptor and clears its deadline). Safe to call from within
+ * the source's own callback.
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ */
+void cxa_posix_runLoop_source_deinit(cxa_posix_runLoop_source_t *const srcIn);
+
+
+/**
+ * @public
+ * @brief Watches a file descriptor for the given events (replacing any
+ * previously watched file descriptor/events for this source). Events are
+ * level-triggered: the source will be called on every iteration while the
+ * condition persists.
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ * @param[in] fdIn the file descriptor to watch
+ * @param[in] eventsIn bitmask of CXA_POSIX_RUNLOOP_EVENT_READABLE and/or
+ * 		CXA_POSIX_RUNLOOP_EVENT_WRITABLE (errors are always reported)
+ *
+ * @return true on success
+ */
+bool cxa_posix_runLoop_source_watchFd(cxa_posix_runLoop_source_t *const srcIn, int fdIn, uint32_t eventsIn);
+
+
+/**
+ * @public
+ * @brief Stops watching the source's file descriptor (if any)
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ */
+void cxa_posix_runLoop_source_unwatchFd(cxa_posix_runLoop_source_t *const srcIn);
+
+
+/**
+ * @public
+ * @brief Sets a (one-shot) deadline for this source, relative to now. Once
+ * elapsed, the source is called with CXA_POSIX_RUNLOOP_EVENT_DEADLINE and the
+ * deadline is cleared. Replaces any existing deadline.
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ * @param[in] deadline_msIn the deadline, in milliseconds from now
+ */
+void cxa_posix_runLoop_source_setDeadline_ms(cxa_posix_runLoop_source_t *const srcIn, uint32_t deadline_msIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the source's run loop is being iterated by the
+ * event-driven run loop (ie. ::cxa_posix_runLoop_instance_iterate has been
+ * called for it). Until then, sources are never called, so objects which must
+ * also work with the classic run loop (::cxa_runLoop_execute) should keep
+ * polling until this returns true.
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ *
+ * @return true if the source will be called when it is ready
+ */
+bool cxa_posix_runLoop_source_isServiced(cxa_posix_runLoop_source_t *const srcIn);
+
+
+/**
+ * @public
+ * @brief Clears any pending deadline for this source
+ *
+ * @param[in] srcIn pointer to a pre-initialized source
+ */
+void cxa_posix_runLoop_source_clearDeadline(cxa_posix_runLoop_source_t *const srcIn);
+
+
+/**
+ * @public
+ * @brief Performs a single iteration of the run loop: waits until a source
+ * is ready (or a deadline / timer expires), calls the ready sources, then
+ * services timers and calls all entries registered with ::cxa_runLoop_addEntry.
+ */
+void cxa_posix_runLoop_iterate(void);
+
+
+/**
+ * @public
+ * @brief Runs the event-driven run loop forever. Use in place of
+ * ::cxa_runLoop_execute.
+ */
+void cxa_posix_runLoop_execute(void);
+
+
+/**
+ * @public
+ * @brief Equivalent to ::cxa_posix_runLoop_iterate, for the given run loop
+ */
+void cxa_posix_runLoop_instance_iterate(cxa_runLoop_t *const rlIn);
+
+
+/**
+ * @public
+ * @brief Equivalent to ::cxa_posix_runLoop_execute, for the given run loop
+ */
+void cxa_posix_runLoop_instance_execute(cxa_runLoop_t *const rlIn);
+
+
+#endif // __linux__
+#endif // CXA_POSIX_RUNLOOP_H_
@@ -1,10 +1,15 @@
 /**
  * @file
  * This file contains prototypes and an architecture-specific implementation of a 
- * timeBase object for the X86 processors. A timeBase object is essentially a
+ * timeBase object for POSIX systems. A timeBase object is essentially a
  * monotonically increasing counter which can be used to calculate macro-scale,
  * relative timeouts (on the order of seconds and minutes).
  *
+ * This implementation is backed by the system's monotonic clock, so it is not
+ * affected when the wall clock is stepped (eg. by NTP). It also provides the
+ * 64-bit nanosecond counter (::cxa_timeBase_getCount64_ns) which never overflows
+ * in practice.
+ *
  * @note This file contains functionality in addition to that already provided in @ref cxa_timeBase.h
  *		
  *
@@ -12,13 +17,13 @@
  * #### Example Usage: ####
  *
  * @code
- * cxa_x86posix_timeBase_t myTimeBase;
- * cxa_x86posix_timeBase_init(&myTimeBase);
+ * cxa_posix_timeBase_init();
  *
  * ...
  *
  * // now use the cxa_timeBase.h common functionality to get the current time
- * uint32_t currTime_us = cxa_timeBase_getCount_us(&myTimeBase.super);
+ * uint32_t currTime_us = cxa_timeBase_getCount_us();
+ * uint64_t currTime_ns = cxa_timeBase_getCount64_ns();
  * @endcode
  *
  *
@@ -49,24 +54,15 @@
 
 
 // ******** global type definitions *********
-/**
- * @private
- */
-struct cxa_timeBase
-{
-	void* _placeHolder;
-};
 
 
 // ******** global function prototypes ********
 /**
  * @public
- * @brief Initializes a timeBase object to use the system's monotonic clock
- * (CLOCK_MONOTONIC) for timing with microSecond resolution.
- *
- * @param[in] tbIn pointer to a pre-allocated POSIX timeBase object
+ * @brief Initializes the timeBase to use the system's monotonic clock
+ * (CLOCK_MONOTONIC) for timing with nanosecond resolution.
  */
-void cxa_posix_timeBase_init(cxa_timeBase_t *const tbIn);
+void cxa_posix_timeBase_init(void);
 
 
 #endif // CXA_POSIX_TIMEBASE_H_
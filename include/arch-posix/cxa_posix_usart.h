@@ -6,6 +6,11 @@
  * @note This file contains functionality restricted to the CXA POSIX implementation.
  *
  * @note This file contains functionality in addition to that already provided in @ref cxa_usart.h
+ *
+ * The port works with either the classic run loop (::cxa_runLoop_execute), which polls it,
+ * or, on Linux, the event-driven run loop (::cxa_posix_runLoop_execute), which only services
+ * it when it is ready. Only in the latter case does its ioStream signal when data arrives
+ * (see ::cxa_ioStream_signalsReadable), so readers on the classic run loop keep polling.
  *		
  *
  *
@@ -49,9 +54,24 @@
 #include <cxa_usart.h>
 #include <cxa_fixedFifo.h>
 #include <cxa_gpio.h>
+#include <cxa_runLoop.h>
+#ifdef __linux__
+	#include <cxa_posix_runLoop.h>
+#endif
 
 
 // ******** global macro definitions ********
+#ifndef CXA_POSIX_USART_RX_BUFFER_SIZE_BYTES
+	#define CXA_POSIX_USART_RX_BUFFER_SIZE_BYTES		1024
+#endif
+
+#ifndef CXA_POSIX_USART_TX_BUFFER_SIZE_BYTES
+	#define CXA_POSIX_USART_TX_BUFFER_SIZE_BYTES		1024
+#endif
+
+#ifndef CXA_POSIX_USART_TX_TIMEOUT_MS
+	#define CXA_POSIX_USART_TX_TIMEOUT_MS				1000
+#endif
 
 
 // ******** global type definitions *********
@@ -63,6 +83,18 @@ typedef struct
 	cxa_usart_t super;
 
 	int fd;
+	bool hasError;
+
+	cxa_fixedFifo_t rxFifo;
+	uint8_t rxFifo_raw[CXA_POSIX_USART_RX_BUFFER_SIZE_BYTES];
+
+	cxa_fixedFifo_t txFifo;
+	uint8_t txFifo_raw[CXA_POSIX_USART_TX_BUFFER_SIZE_BYTES];
+
+	cxa_runLoop_t* runLoop;
+#ifdef __linux__
+	cxa_posix_runLoop_source_t source;
+#endif
 }cxa_posix_usart_t;
 
 
@@ -72,6 +104,15 @@ typedef struct
  * @brief Initializes the specified serial port for no hardware handshaking using the specified baud rate.
  * Defaults to 8n1 for databits / parity / stopbits respectively.
  *
+ * The port is opened non-blocking. Received data is drained from the port (in large reads)
+ * into an internal buffer whenever the port is readable and reads are served from that buffer.
+ * Writes are queued internally and flushed as the port becomes writable. The port is polled
+ * (without blocking) on every iteration of the run loop. On Linux, once the run loop is
+ * iterated by the event-driven run loop (see @ref cxa_posix_runLoop.h), polling stops and the
+ * port is only serviced when it is ready (so the run loop may sleep in between). If a write
+ * doesn't fit in the transmit buffer, the write blocks while the buffer drains (failing only
+ * if the port stops accepting data for CXA_POSIX_USART_TX_TIMEOUT_MS).
+ *
  * @param[in] usartIn pointer to a pre-allocated USART object
  * @param[in] pathIn path to the target UART file device (eg. /dev/ttyUSB0)
  * @param[in] baudRateIn the desired baud rate as specified in termios.h (eg. B115200)
@@ -81,6 +122,16 @@ typedef struct
 bool cxa_posix_usart_init_noHH(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn);
 
 
+/**
+ * @public
+ * @brief Same as ::cxa_posix_usart_init_noHH, but the port's buffers are
+ * serviced by the given run loop (rather than the default run loop).
+ *
+ * @param[in] rlIn the run loop which will service this serial port
+ */
+bool cxa_posix_usart_init_noHH_withRunLoop(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, cxa_runLoop_t *const rlIn);
+
+
 /**
  * Closes the specified serial port.
  *
@@ -200,6 +200,22 @@ bool cxa_array_append(cxa_array_t *const arrIn, void *const itemLocIn);
 void* cxa_array_append_empty(cxa_array_t *const arrIn);
 
 
+/**
+ * @public
+ * @brief Appends a run of contiguous elements to the end of the
+ * given array (in one step) without copying any data. Like
+ * ::cxa_array_append_empty, the elements may then be initialized
+ * "in-place" within the array.
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_array_t object
+ * @param[in] numElemsIn the number of elements to append
+ *
+ * @return a pointer to the first new element location within the
+ *		array object OR NULL on error (not enough room in the array)
+ */
+void* cxa_array_append_emptyElems(cxa_array_t *const arrIn, const size_t numElemsIn);
+
+
 /**
  * @public
  * @brief Removes the specified element from the array (moving
@@ -214,6 +230,21 @@ void* cxa_array_append_empty(cxa_array_t *const arrIn);
 bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn);
 
 
+/**
+ * @public
+ * @brief Removes a run of contiguous elements from the array (moving
+ * all following elements down, in one step)
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_array_t object
+ * @param[in] indexIn the index of the first element which should be removed
+ * @param[in] numElemsIn the number of elements to remove
+ *
+ * @return true if the elements were successfully removed, false on error
+ *		(range extends past the end of the array, etc)
+ */
+bool cxa_array_remove_atIndex_numElems(cxa_array_t *const arrIn, const size_t indexIn, const size_t numElemsIn);
+
+
 /**
  * @public
  * @brief Removes the element at the specified memory location from the
@@ -124,6 +124,18 @@ typedef enum
 }cxa_fixedFifo_onFullAction_t;
 
 
+/**
+ * @public
+ * A contiguous run of elements within the FIFO's buffer
+ * (see ::cxa_fixedFifo_bulkDequeue_peekSegments)
+ */
+typedef struct
+{
+	void* elems;
+	size_t numElems;
+}cxa_fixedFifo_segment_t;
+
+
 #if CXA_FF_MAX_LISTENERS > 0
 /**
  * @public
@@ -242,7 +254,14 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut);
 
 /**
  * @public
- * @brief Convenience function for queueing multiple contiguous elements in one call.
+ * @brief Queues multiple contiguous elements in one call (using at most
+ * 		two copies).
+ *
+ * If there is not enough room for all of the elements, a FIFO initialized with
+ * ::CXA_FF_ON_FULL_DEQUEUE discards its oldest elements to make room (keeping
+ * only the most recent elements if more are supplied than the FIFO can hold),
+ * while a FIFO initialized with ::CXA_FF_ON_FULL_DROP queues as many elements
+ * as will fit.
  *
  * @param[in] fifoIn pointer to the pre-initialized FIFO object
  * @param[in] elemsIn pointer to the contiguous elements which will be copied into
@@ -256,6 +275,46 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut);
 bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn, size_t numElemsIn);
 
 
+/**
+ * @public
+ * @brief Reserves free space within the FIFO buffer so that elements can be
+ * 		written into it directly (eg. by a driver's read call), avoiding an
+ * 		intermediate copy.
+ *
+ * This is the queueing counterpart of ::cxa_fixedFifo_bulkDequeue_peek. The number
+ * of contiguous free elements _may_ be less than the free size of the FIFO (if the
+ * free space wraps around the end of the buffer). Reserving does not discard any
+ * elements, regardless of the FIFO's ::cxa_fixedFifo_onFullAction_t.
+ *
+ * Care should be taken that no other queueing operations are performed on this
+ * FIFO until the written elements are published using ::cxa_fixedFifo_bulkQueue_commit.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut a pointer that will be set with the address of the first
+ * 		free element (within the FIFO buffer itself). Remaining free elements
+ * 		can be assumed to be stored contiguously following.
+ *
+ * @return the number of contiguous elements that may be written
+ */
+size_t cxa_fixedFifo_bulkQueue_reserve(cxa_fixedFifo_t *const fifoIn, void **const elemsOut);
+
+
+/**
+ * @public
+ * @brief Publishes elements previously written into the space returned by
+ * 		::cxa_fixedFifo_bulkQueue_reserve.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] numElemsIn number of elements that were written (may be less than
+ * 		the number of elements reserved)
+ *
+ * @return true if the elements were queued, false if more elements were
+ * 		committed than are contiguously free (in which case only the
+ * 		contiguously free elements were queued)
+ */
+bool cxa_fixedFifo_bulkQueue_commit(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn);
+
+
 /**
  * @public
  * @brief Convenience function for dequeueing multiple elements in one call. This
@@ -266,10 +325,26 @@ bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn,
  * @param[in] numElemsIn number of elements to dequeue from the FIFO.
  *
  * @return true if the desired number of elements were dequeued, false if not
+ * 		(in which case the FIFO is now empty)
  */
 bool cxa_fixedFifo_bulkDequeue(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn);
 
 
+/**
+ * @public
+ * @brief Copies up to the specified number of elements out of the FIFO
+ * 		and dequeues them (using at most two copies).
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut pointer to where the elements should be copied. May be
+ * 		NULL if no copy is desired.
+ * @param[in] maxNumElemsIn the maximum number of elements to dequeue
+ *
+ * @return the number of elements actually dequeued
+ */
+size_t cxa_fixedFifo_bulkDequeue_copy(cxa_fixedFifo_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn);
+
+
 /**
  * @public
  * @brief 'Peeks' at the queue and determines the maximum number of contiguous elements
@@ -295,6 +370,27 @@ bool cxa_fixedFifo_bulkDequeue(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn)
 size_t cxa_fixedFifo_bulkDequeue_peek(cxa_fixedFifo_t *const fifoIn, void **const elemsOut);
 
 
+/**
+ * @public
+ * @brief 'Peeks' at the queue and returns _all_ elements available for dequeue
+ * 		as (up to) two contiguous runs within the FIFO buffer.
+ *
+ * The first segment starts at the oldest element. The second segment is only
+ * non-empty if the stored elements wrap around the end of the buffer, in which
+ * case it starts at the beginning of the buffer.
+ *
+ * The same caveats as ::cxa_fixedFifo_bulkDequeue_peek apply. Once the elements
+ * have been consumed, they should be removed using ::cxa_fixedFifo_bulkDequeue.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] seg1Out the first (oldest) run of elements
+ * @param[out] seg2Out the second run of elements (numElems is 0 if unused)
+ *
+ * @return the total number of elements available for dequeue
+ */
+size_t cxa_fixedFifo_bulkDequeue_peekSegments(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_segment_t *const seg1Out, cxa_fixedFifo_segment_t *const seg2Out);
+
+
 /**
  * @public
  * @brief Determines the size of the FIFO (in number of elements).
@@ -312,7 +408,7 @@ size_t cxa_fixedFifo_getSize_elems(cxa_fixedFifo_t *const fifoIn);
  *
  * @param[in] fifoIn pointer to the pre-initialized FIFO object
  *
- * @return the number of free elements in the FIFO
+ * @return the number of elements that can be queued before the FIFO is full
  */
 size_t cxa_fixedFifo_getFreeSize_elems(cxa_fixedFifo_t *const fifoIn);
 
@@ -0,0 +1,306 @@
+/**
+ * @file
+ * This file contains a lock-free, single-producer / single-consumer variant of
+ * ::cxa_fixedFifo_t. One context (thread, task or interrupt) may queue while another
+ * context dequeues, without disabling interrupts or taking a lock.
+ *
+ * Unlike ::cxa_fixedFifo_t, all elements of the supplied buffer are usable (a FIFO
+ * backed by a 16 element buffer holds 16 elements). Queues to a full FIFO are
+ * always dropped (the producer may not discard elements) and there are no listeners.
+ *
+ * Memory ordering contract (requires C11 atomics):
+ *   - the producer copies elements into the buffer, then publishes them by storing
+ *     the insert index with release semantics. The consumer loads the insert index
+ *     with acquire semantics, so every element it sees as queued is fully written.
+ *   - the consumer copies elements out of the buffer, then frees them by storing
+ *     the remove index with release semantics. The producer loads the remove index
+ *     with acquire semantics, so it never overwrites an element still being read.
+ *   - each index is only ever written by one side.
+ *
+ * Functions are marked as producer-side or consumer-side below. Producer-side
+ * functions must only be called from the producing context and consumer-side
+ * functions only from the consuming context. Functions that only query the FIFO
+ * may be called from either side, but the result may be stale by the time it is used.
+ *
+ * @note On architectures where size_t atomics are not lock-free, this object still
+ * 		works between threads, but must not be used from interrupts.
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_fixedFifo_spsc_t rxFifo;
+ * uint8_t rxFifo_raw[64];
+ * cxa_fixedFifo_spsc_initStd(&rxFifo, rxFifo_raw);
+ *
+ * // in the receive interrupt / reader thread (producer)
+ * cxa_fixedFifo_spsc_queue(&rxFifo, &rxByte);
+ *
+ * // in the run loop (consumer)
+ * uint8_t rxBytes[16];
+ * size_t numBytes = cxa_fixedFifo_spsc_bulkDequeue_copy(&rxFifo, rxBytes, sizeof(rxBytes));
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_FIXED_FIFO_SPSC_H_
+#define CXA_FIXED_FIFO_SPSC_H_
+
+
+// ******** includes ********
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize the fifo with a buffer of an explict data type
+ *
+ * @param[in] fifoIn pointer to FIFO to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which
+ * 		will contain the data for the FIFO.
+ */
+#define cxa_fixedFifo_spsc_initStd(fifoIn, bufferIn)						cxa_fixedFifo_spsc_init((fifoIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_fixedFifo_spsc_t object
+ */
+typedef struct cxa_fixedFifo_spsc cxa_fixedFifo_spsc_t;
+
+
+/**
+ * @private
+ */
+struct cxa_fixedFifo_spsc
+{
+	void *bufferLoc;
+
+	// both indices run from 0 to (2 * maxNumElements) - 1 so that
+	// a full FIFO can be distinguished from an empty one
+	atomic_size_t insertIndex;
+	atomic_size_t removeIndex;
+
+	size_t datatypeSize_bytes;
+	size_t maxNumElements;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the FIFO using the specified buffer (which is empty) to store
+ * elements. Must be completed before either the producer or consumer use the FIFO.
+ *
+ * @param[in] fifoIn pointer to the pre-allocated cxa_fixedFifo_spsc_t object
+ * @param[in] datatypeSize_bytesIn the size of each element that will be inserted
+ * 		into the FIFO (all elements MUST be the same size)
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will
+ * 		be used to store elements in the FIFO (the buffer)
+ * @param[in] bufferMaxSize_bytesIn the maximum size of the chunk of memory (buffer) in bytes
+ */
+void cxa_fixedFifo_spsc_init(cxa_fixedFifo_spsc_t *const fifoIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn);
+
+
+/**
+ * @public
+ * @brief (producer-side) Queues an element in the FIFO
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] elemIn pointer to the element which will be copied
+ * 		into the FIFO's buffer
+ *
+ * @return true if queued, false if the FIFO was full
+ */
+bool cxa_fixedFifo_spsc_queue(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemIn);
+
+
+/**
+ * @public
+ * @brief (producer-side) Queues as many of the given contiguous elements as will
+ * fit (using at most two copies). The elements become visible to the consumer
+ * all at once.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] elemsIn pointer to the contiguous elements which will be copied into
+ * 		the FIFO's buffer
+ * @param[in] numElemsIn the number of elements to queue
+ *
+ * @return the number of elements actually queued
+ */
+size_t cxa_fixedFifo_spsc_bulkQueue(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemsIn, size_t numElemsIn);
+
+
+/**
+ * @public
+ * @brief (producer-side) Reserves contiguous free space within the FIFO buffer
+ * so that elements can be written into it directly. Nothing is visible to the
+ * consumer until ::cxa_fixedFifo_spsc_bulkQueue_commit is called.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut a pointer that will be set with the address of the first
+ * 		free element (within the FIFO buffer itself)
+ *
+ * @return the number of contiguous elements that may be written (may be less
+ * 		than the free size of the FIFO if the free space wraps around)
+ */
+size_t cxa_fixedFifo_spsc_bulkQueue_reserve(cxa_fixedFifo_spsc_t *const fifoIn, void **const elemsOut);
+
+
+/**
+ * @public
+ * @brief (producer-side) Publishes elements previously written into the space
+ * returned by ::cxa_fixedFifo_spsc_bulkQueue_reserve
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] numElemsIn number of elements that were written
+ *
+ * @return true if the elements were queued, false if more elements were
+ * 		committed than are contiguously free (in which case only the
+ * 		contiguously free elements were queued)
+ */
+bool cxa_fixedFifo_spsc_bulkQueue_commit(cxa_fixedFifo_spsc_t *const fifoIn, size_t numElemsIn);
+
+
+/**
+ * @public
+ * @brief (consumer-side) Dequeues an element from the FIFO
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemOut pointer to where the element should be copied. May be
+ * 		NULL if no copy is desired.
+ *
+ * @return true if the FIFO was not empty, false if the FIFO was empty
+ */
+bool cxa_fixedFifo_spsc_dequeue(cxa_fixedFifo_spsc_t *const fifoIn, void *elemOut);
+
+
+/**
+ * @public
+ * @brief (consumer-side) Copies up to the specified number of elements out of
+ * the FIFO and dequeues them (using at most two copies).
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut pointer to where the elements should be copied. May be
+ * 		NULL if no copy is desired.
+ * @param[in] maxNumElemsIn the maximum number of elements to dequeue
+ *
+ * @return the number of elements actually dequeued
+ */
+size_t cxa_fixedFifo_spsc_bulkDequeue_copy(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn);
+
+
+/**
+ * @public
+ * @brief (consumer-side) 'Peeks' at the FIFO so that elements can be parsed in
+ * place, without copying them out. The elements remain queued until
+ * ::cxa_fixedFifo_spsc_bulkDequeue is called.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[out] elemsOut a pointer that will be set with the address of the first
+ * 		element slated for dequeue (within the FIFO buffer itself)
+ *
+ * @return the number of contiguous elements available for dequeue (may be less
+ * 		than the size of the FIFO if the elements wrap around)
+ */
+size_t cxa_fixedFifo_spsc_bulkDequeue_peek(cxa_fixedFifo_spsc_t *const fifoIn, void **const elemsOut);
+
+
+/**
+ * @public
+ * @brief (consumer-side) Dequeues elements without copying them out. Should be
+ * used in concert with ::cxa_fixedFifo_spsc_bulkDequeue_peek.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ * @param[in] numElemsIn number of elements to dequeue from the FIFO
+ *
+ * @return true if the desired number of elements were dequeued, false if not
+ * 		(in which case the FIFO is now empty)
+ */
+bool cxa_fixedFifo_spsc_bulkDequeue(cxa_fixedFifo_spsc_t *const fifoIn, size_t numElemsIn);
+
+
+/**
+ * @public
+ * @brief (consumer-side) Discards all elements currently in the FIFO
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ */
+void cxa_fixedFifo_spsc_clear(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of elements in the FIFO. Exact when called
+ * by the consumer, otherwise a lower bound.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ *
+ * @return the number of elements in the FIFO
+ */
+size_t cxa_fixedFifo_spsc_getSize_elems(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of free elements in the FIFO. Exact when called
+ * by the producer, otherwise a lower bound.
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ *
+ * @return the number of elements that can be queued before the FIFO is full
+ */
+size_t cxa_fixedFifo_spsc_getFreeSize_elems(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+/**
+ * @public
+ * @brief Determines the maximum number of elements the FIFO can hold
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ *
+ * @return the capacity of the FIFO (the number of elements in its buffer)
+ */
+size_t cxa_fixedFifo_spsc_getMaxSize_elems(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the FIFO is full (cannot hold any more elements)
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ *
+ * @return true if the FIFO cannot hold any more elements
+ */
+bool cxa_fixedFifo_spsc_isFull(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the FIFO is empty (does not hold any elements)
+ *
+ * @param[in] fifoIn pointer to the pre-initialized FIFO object
+ *
+ * @return true if the FIFO does not currently contain any elements
+ */
+bool cxa_fixedFifo_spsc_isEmpty(cxa_fixedFifo_spsc_t *const fifoIn);
+
+
+#endif // CXA_FIXED_FIFO_SPSC_H_
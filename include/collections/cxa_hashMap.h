@@ -0,0 +1,319 @@
+/**
+ * @file
+ * This file contains an implementation of a statically allocated, fixed-capacity
+ * hash map. Like ::cxa_array_t, the map itself does not hold any data, rather, it
+ * stores keys and values in an external buffer supplied during initialization.
+ * Nothing is allocated on the heap.
+ *
+ * Keys are either a fixed number of bytes (compared with memcmp) or nul-terminated
+ * strings of a fixed maximum length. Values are a fixed number of bytes. Collisions
+ * are resolved using open addressing (linear probing, ordered "Robin Hood" style) and
+ * removal shifts following entries back rather than leaving tombstones, so lookup
+ * performance does not degrade as entries are added and removed.
+ *
+ * Lookups stay fast as long as the map is not too full. Size the buffer so that the
+ * map is (at most) ~75% full.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * #define MAX_NUM_METHODS			16
+ * #define MAX_METHOD_NAME_LEN		23
+ *
+ * cxa_hashMap_t methods;
+ * _Alignas(CXA_HASHMAP_ALIGNMENT_BYTES) uint8_t methods_raw[CXA_HASHMAP_BUFFER_SIZE_BYTES(MAX_NUM_METHODS, MAX_METHOD_NAME_LEN+1, sizeof(cb_method_t))];
+ * cxa_hashMap_init_stringKeys(&methods, MAX_METHOD_NAME_LEN, sizeof(cb_method_t), methods_raw, sizeof(methods_raw), NULL, NULL);
+ *
+ * cb_method_t cb = myMethodHandler;
+ * cxa_hashMap_put(&methods, "getStatus", &cb);
+ *
+ * ...
+ *
+ * cb_method_t* foundCb = (cb_method_t*)cxa_hashMap_get(&methods, "getStatus");
+ * if( foundCb != NULL ) (*foundCb)();
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_HASHMAP_H_
+#define CXA_HASHMAP_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cxa_config.h>
+
+
+// ******** global macro definitions ********
+#ifndef CXA_HASHMAP_ALIGNMENT_BYTES
+	#define CXA_HASHMAP_ALIGNMENT_BYTES			_Alignof(max_align_t)
+#endif
+
+
+/**
+ * @private
+ */
+#define CXA_HASHMAP_ALIGN(numBytesIn)			((((numBytesIn) + CXA_HASHMAP_ALIGNMENT_BYTES - 1) / CXA_HASHMAP_ALIGNMENT_BYTES) * CXA_HASHMAP_ALIGNMENT_BYTES)
+
+
+/**
+ * @public
+ * @brief Determines the size of each entry (key, value and bookkeeping) within the map's buffer
+ *
+ * @param[in] keySize_bytesIn the size of each key (for string keys, the maximum
+ * 		length of the string plus one)
+ * @param[in] valueSize_bytesIn the size of each value
+ */
+#define CXA_HASHMAP_SLOT_SIZE_BYTES(keySize_bytesIn, valueSize_bytesIn)						\
+		(CXA_HASHMAP_ALIGN(sizeof(cxa_hashMap_slotHeader_t)) + CXA_HASHMAP_ALIGN(keySize_bytesIn) + CXA_HASHMAP_ALIGN(valueSize_bytesIn))
+
+
+/**
+ * @public
+ * @brief Determines the buffer size needed for a map holding the given number of entries
+ *
+ * @param[in] maxNumEntriesIn the maximum number of entries in the map
+ * @param[in] keySize_bytesIn the size of each key (for string keys, the maximum
+ * 		length of the string plus one)
+ * @param[in] valueSize_bytesIn the size of each value
+ */
+#define CXA_HASHMAP_BUFFER_SIZE_BYTES(maxNumEntriesIn, keySize_bytesIn, valueSize_bytesIn)	\
+		((maxNumEntriesIn) * CXA_HASHMAP_SLOT_SIZE_BYTES((keySize_bytesIn), (valueSize_bytesIn)))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_hashMap_t object
+ */
+typedef struct cxa_hashMap cxa_hashMap_t;
+
+
+/**
+ * @public
+ * @brief Callback used to hash keys
+ *
+ * @param[in] keyIn pointer to the key to hash
+ * @param[in] keySize_bytesIn the size of the key (for string keys, the
+ * 		length of the string, excluding the terminator)
+ * @param[in] userVarIn the user-supplied pointer passed during initialization
+ *
+ * @return the hash of the key
+ */
+typedef uint32_t (*cxa_hashMap_cb_hash_t)(const void *const keyIn, const size_t keySize_bytesIn, void *const userVarIn);
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	uint32_t hash;
+	bool isUsed;
+}cxa_hashMap_slotHeader_t;
+
+
+/**
+ * @private
+ */
+struct cxa_hashMap
+{
+	void *bufferLoc;
+	size_t numSlots;
+	size_t numEntries;
+
+	size_t keySize_bytes;
+	size_t valueSize_bytes;
+	bool hasStringKeys;
+
+	size_t keyOffset_bytes;
+	size_t valueOffset_bytes;
+	size_t slotSize_bytes;
+
+	cxa_hashMap_cb_hash_t cb_hash;
+	void *userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the map (which is empty) with fixed-size keys, using the
+ * specified buffer to store entries.
+ *
+ * @param[in] mapIn pointer to the pre-allocated cxa_hashMap_t object
+ * @param[in] keySize_bytesIn the size of each key
+ * @param[in] valueSize_bytesIn the size of each value
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will be
+ * 		used to store entries (must be aligned to CXA_HASHMAP_ALIGNMENT_BYTES)
+ * @param[in] bufferMaxSize_bytesIn the size of the buffer, in bytes (see
+ * 		CXA_HASHMAP_BUFFER_SIZE_BYTES)
+ * @param[in] cb_hashIn callback used to hash keys (NULL to use ::cxa_hashMap_hash_fnv1a)
+ * @param[in] userVarIn user-supplied pointer passed to the hash callback
+ */
+void cxa_hashMap_init(cxa_hashMap_t *const mapIn, const size_t keySize_bytesIn, const size_t valueSize_bytesIn,
+					  void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+					  cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn);
+
+
+/**
+ * @public
+ * @brief Initializes the map (which is empty) with nul-terminated string keys,
+ * using the specified buffer to store entries.
+ *
+ * @param[in] mapIn pointer to the pre-allocated cxa_hashMap_t object
+ * @param[in] maxKeyLen_bytesIn the maximum length of each key (excluding the terminator)
+ * @param[in] valueSize_bytesIn the size of each value
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will be
+ * 		used to store entries (must be aligned to CXA_HASHMAP_ALIGNMENT_BYTES)
+ * @param[in] bufferMaxSize_bytesIn the size of the buffer, in bytes (see
+ * 		CXA_HASHMAP_BUFFER_SIZE_BYTES, using a key size of maxKeyLen_bytesIn+1)
+ * @param[in] cb_hashIn callback used to hash keys (NULL to use ::cxa_hashMap_hash_fnv1a)
+ * @param[in] userVarIn user-supplied pointer passed to the hash callback
+ */
+void cxa_hashMap_init_stringKeys(cxa_hashMap_t *const mapIn, const size_t maxKeyLen_bytesIn, const size_t valueSize_bytesIn,
+								 void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+								 cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn);
+
+
+/**
+ * @public
+ * @brief Adds an entry to the map, or overwrites the value of the
+ * existing entry with the same key
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ * @param[in] keyIn pointer to the key (which will be copied into the map)
+ * @param[in] valueIn pointer to the value (which will be copied into the map)
+ *
+ * @return true on success, false if the map is full (or a string key is too long)
+ */
+bool cxa_hashMap_put(cxa_hashMap_t *const mapIn, const void *const keyIn, void *const valueIn);
+
+
+/**
+ * @public
+ * @brief Adds an entry to the map (or finds the existing entry with the same key)
+ * but does not copy any data to the value. This allows the value to be
+ * initialized "in-place" within the map.
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ * @param[in] keyIn pointer to the key (which will be copied into the map)
+ *
+ * @return a pointer to the value within the map OR NULL if the map is full
+ * 		(or a string key is too long)
+ */
+void* cxa_hashMap_put_empty(cxa_hashMap_t *const mapIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief Finds the value associated with the given key
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ * @param[in] keyIn pointer to the key
+ *
+ * @return a pointer to the value within the map, or NULL if no entry has this key
+ */
+void* cxa_hashMap_get(cxa_hashMap_t *const mapIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief Removes the entry with the given key from the map. Pointers
+ * previously returned for other entries may no longer be valid.
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ * @param[in] keyIn pointer to the key
+ *
+ * @return true if the entry was removed, false if no entry has this key
+ */
+bool cxa_hashMap_remove(cxa_hashMap_t *const mapIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief Removes all entries from the map
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ */
+void cxa_hashMap_clear(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Determines the number of entries in the map
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ *
+ * @return the number of entries in the map
+ */
+size_t cxa_hashMap_getSize_elems(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Determines the maximum number of entries this map can hold
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ *
+ * @return the maximum number of entries this map can hold
+ */
+size_t cxa_hashMap_getMaxSize_elems(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the map is full (cannot hold any more entries)
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ *
+ * @return true if the map cannot hold any more entries
+ */
+bool cxa_hashMap_isFull(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the map is empty (does not hold any entries)
+ *
+ * @param[in] mapIn pointer to the pre-initialized cxa_hashMap_t object
+ *
+ * @return true if the map does not currently contain any entries
+ */
+bool cxa_hashMap_isEmpty(cxa_hashMap_t *const mapIn);
+
+
+/**
+ * @public
+ * @brief The default hash function (32-bit FNV-1a). May be called by
+ * custom hash functions.
+ *
+ * @param[in] keyIn pointer to the key to hash
+ * @param[in] keySize_bytesIn the size of the key
+ * @param[in] userVarIn unused
+ *
+ * @return the hash of the key
+ */
+uint32_t cxa_hashMap_hash_fnv1a(const void *const keyIn, const size_t keySize_bytesIn, void *const userVarIn);
+
+
+#endif // CXA_HASHMAP_H_
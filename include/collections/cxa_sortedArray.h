@@ -0,0 +1,209 @@
+/**
+ * @file
+ * This file contains a sorted companion to ::cxa_array_t. Elements are kept in
+ * order (according to a user-supplied comparator) within the same statically
+ * allocated, fixed-max-length storage, so lookups can use a binary search
+ * (O(log n)) rather than a linear scan.
+ *
+ * The comparator is called with a key and an element (like bsearch). When inserting,
+ * the element being inserted is passed as the key, so a comparator which looks up
+ * elements by a field should accept a pointer to an element as a valid key (eg.
+ * by making that field the first member of the element).
+ *
+ * The underlying ::cxa_array_t may be retrieved (using ::cxa_sortedArray_getArray)
+ * for iteration and indexed access, but must not be modified directly.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * typedef struct
+ * {
+ * 		uint16_t id;			// key must be the first member
+ * 		void* handler;
+ * }myEntry_t;
+ *
+ * static int compareById(const void *const keyIn, const void *const elemIn, void *const userVarIn)
+ * {
+ * 		uint16_t key = *(uint16_t*)keyIn;
+ * 		uint16_t elemId = ((myEntry_t*)elemIn)->id;
+ * 		return (key < elemId) ? -1 : ((key > elemId) ? 1 : 0);
+ * }
+ *
+ * cxa_sortedArray_t myArray;
+ * myEntry_t myArray_buffer[16];
+ * cxa_sortedArray_initStd(&myArray, myArray_buffer, compareById, NULL);
+ *
+ * myEntry_t newEntry = {.id=42, .handler=NULL};
+ * cxa_sortedArray_insertSorted(&myArray, &newEntry);
+ *
+ * uint16_t idToFind = 42;
+ * myEntry_t* foundEntry = (myEntry_t*)cxa_sortedArray_find(&myArray, &idToFind, NULL);
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_SORTED_ARRAY_H_
+#define CXA_SORTED_ARRAY_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <cxa_array.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Shortcut to initialize a sorted array with a buffer of an explicit data type
+ *
+ * @param[in] arrIn pointer to the sorted array to initialize
+ * @param[in] bufferIn pointer to the declared c-style array which
+ * 		will contain the data for the array
+ * @param[in] cb_compareIn the comparator used to order the elements
+ * @param[in] userVarIn user-supplied pointer passed to the comparator
+ */
+#define cxa_sortedArray_initStd(arrIn, bufferIn, cb_compareIn, userVarIn)		cxa_sortedArray_init((arrIn), sizeof(*(bufferIn)), ((void*)(bufferIn)), sizeof(bufferIn), (cb_compareIn), (userVarIn))
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_sortedArray_t object
+ */
+typedef struct cxa_sortedArray cxa_sortedArray_t;
+
+
+/**
+ * @public
+ * @brief Callback used to order the elements of the array
+ *
+ * @param[in] keyIn pointer to the key being searched for (or the element
+ * 		being inserted)
+ * @param[in] elemIn pointer to an element within the array
+ * @param[in] userVarIn the user-supplied pointer passed during initialization
+ *
+ * @return less than 0 if the key orders before the element, 0 if the key
+ * 		matches the element, greater than 0 if the key orders after the element
+ */
+typedef int (*cxa_sortedArray_cb_compare_t)(const void *const keyIn, const void *const elemIn, void *const userVarIn);
+
+
+/**
+ * @private
+ */
+struct cxa_sortedArray
+{
+	cxa_array_t array;
+
+	cxa_sortedArray_cb_compare_t cb_compare;
+	void *userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the sorted array using the specified buffer (which is empty)
+ * to store elements.
+ *
+ * @param[in] arrIn pointer to the pre-allocated cxa_sortedArray_t object
+ * @param[in] datatypeSize_bytesIn the size of each element that will be inserted
+ * 		into the array (all elements MUST be the same size)
+ * @param[in] bufferLocIn pointer to the pre-allocated chunk of memory that will
+ * 		be used to store elements in the array (the buffer)
+ * @param[in] bufferMaxSize_bytesIn the maximum size of the chunk of memory (buffer) in bytes
+ * @param[in] cb_compareIn the comparator used to order the elements
+ * @param[in] userVarIn user-supplied pointer passed to the comparator
+ */
+void cxa_sortedArray_init(cxa_sortedArray_t *const arrIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						  cxa_sortedArray_cb_compare_t cb_compareIn, void *const userVarIn);
+
+
+/**
+ * @public
+ * @brief Copies an element into the array at its sorted position. Elements which
+ * compare equal to existing elements are inserted after them.
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_sortedArray_t object
+ * @param[in] itemLocIn pointer to the element which will be copied into the array
+ *
+ * @return true on successful insertion, false if the array is full
+ */
+bool cxa_sortedArray_insertSorted(cxa_sortedArray_t *const arrIn, void *const itemLocIn);
+
+
+/**
+ * @public
+ * @brief Determines the index of the first element which does not order before
+ * the given key (using a binary search).
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_sortedArray_t object
+ * @param[in] keyIn pointer to the key to search for
+ *
+ * @return the index at which the key is (or would be inserted), equal to the
+ * 		size of the array if all elements order before the key
+ */
+size_t cxa_sortedArray_lowerBound(cxa_sortedArray_t *const arrIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief Finds the first element matching the given key (using a binary search)
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_sortedArray_t object
+ * @param[in] keyIn pointer to the key to search for
+ * @param[out] indexOut if non-NULL, set to the index of the matching
+ * 		element (if found)
+ *
+ * @return pointer to the matching element (within the array's buffer)
+ * 		or NULL if no element matches
+ */
+void* cxa_sortedArray_find(cxa_sortedArray_t *const arrIn, const void *const keyIn, size_t *const indexOut);
+
+
+/**
+ * @public
+ * @brief Removes the first element matching the given key (moving all
+ * following elements down)
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_sortedArray_t object
+ * @param[in] keyIn pointer to the key of the element to remove
+ *
+ * @return true if an element was removed, false if no element matches
+ */
+bool cxa_sortedArray_removeKey(cxa_sortedArray_t *const arrIn, const void *const keyIn);
+
+
+/**
+ * @public
+ * @brief Returns the underlying (sorted) array. It may be used with
+ * ::cxa_array_iterate, ::cxa_array_get, ::cxa_array_getSize_elems, etc.
+ * but must not be modified, except by ::cxa_array_remove_atIndex,
+ * ::cxa_array_remove or ::cxa_array_clear (which preserve the order).
+ *
+ * @param[in] arrIn pointer to the pre-initialized cxa_sortedArray_t object
+ *
+ * @return pointer to the underlying array
+ */
+cxa_array_t* cxa_sortedArray_getArray(cxa_sortedArray_t *const arrIn);
+
+
+#endif // CXA_SORTED_ARRAY_H_
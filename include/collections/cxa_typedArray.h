@@ -0,0 +1,189 @@
+/**
+ * @file
+ * This file contains a macro for declaring typed, statically sized arrays. Each
+ * declared array embeds a ::cxa_array_t (so it remains compatible with the generic
+ * array API) but its accessors are generated inline for the specific element type,
+ * so the element size is known at compile time.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * typedef struct
+ * {
+ * 		uint8_t id;
+ * 		uint16_t value;
+ * }mySample_t;
+ *
+ * // declares mySampleArray_t along with mySampleArray_init, mySampleArray_append, etc.
+ * CXA_ARRAY_DECLARE(mySampleArray, mySample_t, 32)
+ *
+ * mySampleArray_t samples;
+ * mySampleArray_init(&samples);
+ *
+ * mySample_t newSample = {.id=1, .value=1234};
+ * mySampleArray_append(&samples, &newSample);
+ * mySample_t* firstSample = mySampleArray_get(&samples, 0);
+ *
+ * // the generic API still works on the embedded array
+ * cxa_array_iterate(mySampleArray_getArray(&samples), currSample, mySample_t)
+ * {
+ * 		...
+ * }
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_TYPED_ARRAY_H_
+#define CXA_TYPED_ARRAY_H_
+
+
+// ******** includes ********
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <cxa_array.h>
+#include <cxa_assert.h>
+
+
+// ******** global macro definitions ********
+/**
+ * @public
+ * @brief Declares a typed, statically sized array (and inline accessors for it)
+ *
+ * The accessors have the same semantics as their generic cxa_array counterparts,
+ * but since the element type (and size) is known at compile time, elements are
+ * copied by assignment rather than a runtime-sized memcpy (allowing the compiler
+ * to use a single load / store for small elements).
+ *
+ * The declared type embeds a ::cxa_array_t (initialized to use its own storage)
+ * so it can still be used with the generic API (eg. ::cxa_array_iterate) via
+ * `<name>_getArray`.
+ *
+ * @param[in] nameIn prefix for the declared type (`<name>_t`) and accessors
+ * @param[in] elemTypeIn the datatype of each element
+ * @param[in] maxNumElemsIn the maximum number of elements in the array
+ */
+#define CXA_ARRAY_DECLARE(nameIn, elemTypeIn, maxNumElemsIn)																\
+	typedef struct																											\
+	{																														\
+		cxa_array_t array;																									\
+		elemTypeIn buffer[maxNumElemsIn];																					\
+	}nameIn##_t;																											\
+																															\
+	static inline void nameIn##_init(nameIn##_t *const arrIn)																\
+	{																														\
+		cxa_array_initStd(&arrIn->array, arrIn->buffer);																	\
+	}																														\
+																															\
+	static inline bool nameIn##_append(nameIn##_t *const arrIn, const elemTypeIn *const itemLocIn)						\
+	{																														\
+		cxa_assert(arrIn);																									\
+		cxa_assert(itemLocIn);																								\
+		if( arrIn->array.insertIndex >= (maxNumElemsIn) ) return false;													\
+		arrIn->buffer[arrIn->array.insertIndex++] = *itemLocIn;															\
+		return true;																										\
+	}																														\
+																															\
+	static inline elemTypeIn* nameIn##_append_empty(nameIn##_t *const arrIn)												\
+	{																														\
+		cxa_assert(arrIn);																									\
+		if( arrIn->array.insertIndex >= (maxNumElemsIn) ) return NULL;													\
+		return &arrIn->buffer[arrIn->array.insertIndex++];																	\
+	}																														\
+																															\
+	static inline bool nameIn##_remove_atIndex(nameIn##_t *const arrIn, const size_t indexIn)								\
+	{																														\
+		cxa_assert(arrIn);																									\
+		if( indexIn >= arrIn->array.insertIndex ) return false;															\
+		memmove(&arrIn->buffer[indexIn], &arrIn->buffer[indexIn+1], (arrIn->array.insertIndex-(indexIn+1)) * sizeof(elemTypeIn));	\
+		arrIn->array.insertIndex--;																							\
+		return true;																										\
+	}																														\
+																															\
+	static inline elemTypeIn* nameIn##_get(nameIn##_t *const arrIn, const size_t indexIn)									\
+	{																														\
+		cxa_assert(arrIn);																									\
+		return (indexIn < arrIn->array.insertIndex) ? &arrIn->buffer[indexIn] : NULL;										\
+	}																														\
+																															\
+	static inline bool nameIn##_overwrite(nameIn##_t *const arrIn, const size_t indexIn, const elemTypeIn *const itemLocIn)	\
+	{																														\
+		cxa_assert(arrIn);																									\
+		cxa_assert(itemLocIn);																								\
+		if( indexIn >= arrIn->array.insertIndex ) return false;															\
+		arrIn->buffer[indexIn] = *itemLocIn;																				\
+		return true;																										\
+	}																														\
+																															\
+	static inline bool nameIn##_insert(nameIn##_t *const arrIn, const size_t indexIn, const elemTypeIn *const itemLocIn)	\
+	{																														\
+		cxa_assert(arrIn);																									\
+		cxa_assert(itemLocIn);																								\
+		if( arrIn->array.insertIndex >= (maxNumElemsIn) ) return false;													\
+		if( indexIn > arrIn->array.insertIndex ) return false;																\
+		memmove(&arrIn->buffer[indexIn+1], &arrIn->buffer[indexIn], (arrIn->array.insertIndex-indexIn) * sizeof(elemTypeIn));	\
+		arrIn->array.insertIndex++;																							\
+		arrIn->buffer[indexIn] = *itemLocIn;																				\
+		return true;																										\
+	}																														\
+																															\
+	static inline size_t nameIn##_getSize_elems(nameIn##_t *const arrIn)													\
+	{																														\
+		cxa_assert(arrIn);																									\
+		return arrIn->array.insertIndex;																					\
+	}																														\
+																															\
+	static inline size_t nameIn##_getMaxSize_elems(nameIn##_t *const arrIn)												\
+	{																														\
+		(void)arrIn;																										\
+		return (maxNumElemsIn);																								\
+	}																														\
+																															\
+	static inline bool nameIn##_isFull(nameIn##_t *const arrIn)															\
+	{																														\
+		cxa_assert(arrIn);																									\
+		return (arrIn->array.insertIndex >= (maxNumElemsIn));																\
+	}																														\
+																															\
+	static inline bool nameIn##_isEmpty(nameIn##_t *const arrIn)															\
+	{																														\
+		cxa_assert(arrIn);																									\
+		return (arrIn->array.insertIndex == 0);																				\
+	}																														\
+																															\
+	static inline void nameIn##_clear(nameIn##_t *const arrIn)																\
+	{																														\
+		cxa_assert(arrIn);																									\
+		arrIn->array.insertIndex = 0;																						\
+	}																														\
+																															\
+	static inline cxa_array_t* nameIn##_getArray(nameIn##_t *const arrIn)													\
+	{																														\
+		return &arrIn->array;																								\
+	}
+
+
+// ******** global type definitions *********
+
+
+// ******** global function prototypes ********
+
+
+#endif // CXA_TYPED_ARRAY_H_
@@ -30,6 +30,13 @@
 
 
 // ******** global macro definitions ********
+#ifndef CXA_FDLINEPARSER_READ_BLOCK_SIZE_BYTES
+	#define CXA_FDLINEPARSER_READ_BLOCK_SIZE_BYTES			64
+#endif
+
+#ifndef CXA_FDLINEPARSER_MAXNUM_BYTES_PER_UPDATE
+	#define CXA_FDLINEPARSER_MAXNUM_BYTES_PER_UPDATE		512
+#endif
 
 
 // ******** global type definitions *********
@@ -24,6 +24,7 @@
 #include <cxa_logger_header.h>
 #include <cxa_mqtt_message.h>
 #include <cxa_protocolParser_mqtt.h>
+#include <cxa_runLoop.h>
 #include <cxa_stateMachine.h>
 #include <cxa_timeDiff.h>
 #include <cxa_config.h>
@@ -163,6 +164,20 @@ struct cxa_mqtt_client
 // ******** global function prototypes ********
 void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *const iosIn, uint16_t keepAliveTimeout_sIn, char *const clientIdIn);
 
+/**
+ * @public
+ * @brief Same as ::cxa_mqtt_client_init, but the client (and its protocol
+ * parser) are executed by the given run loop (rather than the default run loop)
+ */
+void cxa_mqtt_client_init_withRunLoop(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *const iosIn, uint16_t keepAliveTimeout_sIn, char *const clientIdIn,
+									  cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @return the run loop which executes this client
+ */
+cxa_runLoop_t* cxa_mqtt_client_getRunLoop(cxa_mqtt_client_t *const clientIn);
+
 bool cxa_mqtt_client_setWillMessage(cxa_mqtt_client_t *const clientIn, cxa_mqtt_qosLevel_t qosIn, bool retainIn,
 									char* topicNameIn, void *const payloadIn, size_t payloadLen_bytesIn);
 
@@ -22,9 +22,19 @@
 #include <cxa_protocolParser.h>
 #include <cxa_mqtt_message.h>
 #include <cxa_stateMachine.h>
+#include <cxa_timer.h>
 
 
 // ******** global macro definitions ********
+/**
+ * @public
+ * Maximum number of bytes the parser will consume from its ioStream during
+ * a single run loop update. Received bytes are drained until either the
+ * ioStream runs dry or this budget is exhausted.
+ */
+#ifndef CXA_PROTOCOLPARSER_MQTT_MAXNUM_RX_BYTES_PER_UPDATE
+	#define CXA_PROTOCOLPARSER_MQTT_MAXNUM_RX_BYTES_PER_UPDATE		1024
+#endif
 
 
 // ******** global type definitions *********
@@ -34,11 +44,21 @@ typedef struct
 
 	cxa_stateMachine_t stateMachine;
 	size_t remainingBytesToReceive;
+
+	cxa_timer_t timer_receptionTimeout;
 }cxa_protocolParser_mqtt_t;
 
 
 // ******** global function prototypes ********
 void cxa_protocolParser_mqtt_init(cxa_protocolParser_mqtt_t *const mppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn);
 
+/**
+ * @public
+ * @brief Same as ::cxa_protocolParser_mqtt_init, but the parser is
+ * executed by the given run loop (rather than the default run loop)
+ */
+void cxa_protocolParser_mqtt_init_withRunLoop(cxa_protocolParser_mqtt_t *const mppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
+											  cxa_runLoop_t *const rlIn);
+
 
 #endif // CXA_PROTOCOLPARSER_MQTT_H_
@@ -155,6 +155,8 @@ struct cxa_mqtt_rpc_node
 	cxa_mqtt_rpc_node_scm_handleMessage_upstream_t scm_handleMessage_upstream;
 	cxa_mqtt_rpc_node_scm_handleMessage_downstream_t scm_handleMessage_downstream;
 
+	cxa_runLoop_t* runLoop;
+
 	cxa_logger_t logger;
 };
 
@@ -162,10 +164,20 @@ struct cxa_mqtt_rpc_node
 // ******** global function prototypes ********
 /**
  * @public
+ * @brief Initializes the node. The node is executed by the same run loop
+ * as its parent (or the default run loop if it has no parent).
  */
 void cxa_mqtt_rpc_node_vinit(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_node_t *const parentNodeIn, const char *nameFmtIn, va_list varArgsIn);
 
 
+/**
+ * @public
+ * @brief Same as ::cxa_mqtt_rpc_node_vinit, but the node is executed by the given run loop
+ */
+void cxa_mqtt_rpc_node_vinit_withRunLoop(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_node_t *const parentNodeIn, cxa_runLoop_t *const rlIn,
+										 const char *nameFmtIn, va_list varArgsIn);
+
+
 /**
  * @public
  */
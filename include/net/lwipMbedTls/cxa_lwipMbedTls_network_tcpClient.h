@@ -43,6 +43,14 @@
 	#define CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_MAXPORTNUMLEN_BYTES			5
 #endif
 
+#ifndef CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFER_SIZE_BYTES
+	#define CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFER_SIZE_BYTES			1024
+#endif
+
+#ifndef CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_TXBUFFER_SIZE_BYTES
+	#define CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_TXBUFFER_SIZE_BYTES			1024
+#endif
+
 
 // ******** global type definitions *********
 /**
@@ -77,6 +85,12 @@ struct cxa_lwipMbedTls_network_tcpClient
 	    mbedtls_ssl_config conf;
 	    mbedtls_net_context server_fd;
 
+	    uint8_t rxBuffer[CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_RXBUFFER_SIZE_BYTES];
+	    size_t rxBuffer_startIndex;
+	    size_t rxBuffer_endIndex;
+
+	    uint8_t txBuffer[CXA_LWIPMBEDTLS_NETWORK_TCPCLIENT_TXBUFFER_SIZE_BYTES];
+
 	    struct
 		{
 			bool areBasicsInitialized;
@@ -19,6 +19,35 @@
 
 /**
  * @file
+ * This file contains the run loop, which repeatedly calls registered entries
+ * (and services timers).
+ *
+ * A default run loop is always available and is used by the functions which do
+ * not take a run loop (eg. ::cxa_runLoop_addEntry). Additional run loops may be
+ * created with ::cxa_runLoop_init (eg. one per thread/core) and objects bound to
+ * them using their respective '_withRunLoop' initializers. Each run loop must
+ * only be iterated from a single thread.
+ *
+ * Objects bound to different run loops may run concurrently, so only modules
+ * whose shared state is guarded (by ::cxa_criticalSection_enter) may be used
+ * from more than one run loop at a time. Currently these are: the run loop
+ * itself, ::cxa_timer_t, ::cxa_stateMachine_t, the protocol parsers, the mqtt
+ * client / rpc nodes (and the mqtt message factory they share) and the logger.
+ * Any single object must only be used from the run loop it is bound to.
+ *
+ * When CXA_RUNLOOP_POST_ENABLE is defined, other threads (and signal handlers)
+ * may hand work to a run loop using ::cxa_runLoop_post. Posted callbacks are
+ * called, in order, at the start of the run loop's next iteration. The queue is
+ * lock-free (requires C11 atomics) and does not allocate.
+ *
+ * When CXA_RUNLOOP_TICKLESS_IDLE_ENABLE is defined, ::cxa_runLoop_execute idles
+ * (see @ref cxa_idle.h) between iterations until the next timer is due, an
+ * interrupt/signal occurs, or work is posted. Idling is opt-in per entry: entries
+ * added with ::cxa_runLoop_addEntry (or _withPriority) are polled and keep the
+ * run loop from idling at all. Only entries added with ::cxa_runLoop_addEntry_eventDriven
+ * allow it to idle, so they must call ::cxa_runLoop_signalMoreWork whenever they
+ * need to be called again promptly (and otherwise rely on a timer, posted work or
+ * an interrupt to wake the run loop).
  *
  * @author Christopher Armenio
  */
@@ -28,6 +57,16 @@
 #include <stdbool.h>
 #include <cxa_array.h>
 #include <cxa_config.h>
+#include <cxa_timeDiff.h>
+#include <cxa_timer.h>
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+#include <cxa_ioStream.h>
+#endif
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+#include <stdatomic.h>
+#endif
 
 
 // ******** global macro definitions ********
@@ -35,21 +74,396 @@
 	#define CXA_RUN_LOOP_MAX_NUM_ENTRIES				10
 #endif
 
+#ifndef CXA_RUNLOOP_BACKGROUND_BUDGET_US
+	#define CXA_RUNLOOP_BACKGROUND_BUDGET_US			0
+#endif
+
+/**
+ * Number of execution time histogram buckets kept by the profiler (when
+ * CXA_RUNLOOP_PROFILER_ENABLE is defined). Bucket 0 counts calls which took
+ * less than 1us, bucket n counts calls which took [2^(n-1), 2^n) us and the
+ * last bucket also counts anything longer.
+ */
+#ifndef CXA_RUNLOOP_PROFILER_NUM_BUCKETS
+	#define CXA_RUNLOOP_PROFILER_NUM_BUCKETS			16
+#endif
+
+/**
+ * Maximum number of posted callbacks which may be waiting for the run loop
+ * (when CXA_RUNLOOP_POST_ENABLE is defined). Must be a power of 2.
+ */
+#ifndef CXA_RUNLOOP_POST_QUEUE_SIZE
+	#define CXA_RUNLOOP_POST_QUEUE_SIZE					16
+#endif
+
 
 // ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_runLoop_t object
+ */
+typedef struct cxa_runLoop cxa_runLoop_t;
+
+
 /**
  * @public
  */
 typedef void (*cxa_runLoop_cb_update_t)(void* userVarIn);
 
 
+/**
+ * @public
+ * @brief Called (from the posting thread) after work is posted to a run loop,
+ * so that a sleeping run loop can be woken up. Must be async-signal-safe if
+ * work is posted from signal handlers.
+ */
+typedef void (*cxa_runLoop_cb_wake_t)(void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Determines how often (and in what order) an entry is called
+ */
+typedef enum
+{
+	/// called first, and again after every background entry
+	CXA_RUNLOOP_PRIORITY_HIGH,
+
+	/// called once per iteration (default)
+	CXA_RUNLOOP_PRIORITY_NORMAL,
+
+	/// called round-robin, only while the background budget allows
+	CXA_RUNLOOP_PRIORITY_BACKGROUND
+}cxa_runLoop_priority_t;
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+/**
+ * @public
+ * @brief Execution statistics for a single run loop entry
+ */
+typedef struct
+{
+	cxa_runLoop_cb_update_t cb;
+	void* userVar;
+
+	uint32_t numCalls;
+	uint64_t cumulativeTime_us;
+	uint32_t maxTime_us;
+	uint32_t histogram[CXA_RUNLOOP_PROFILER_NUM_BUCKETS];
+}cxa_runLoop_profile_t;
+#endif
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_runLoop_cb_update_t cb;
+	void *userVar;
+
+	cxa_runLoop_priority_t priority;
+	uint32_t avgRunTime_us;
+
+	// event-driven entries signal when they need to be called (polled entries prevent idling)
+	bool isEventDriven;
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	cxa_runLoop_profile_t profile;
+#endif
+}cxa_runLoop_entry_t;
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+/**
+ * @private
+ */
+typedef struct
+{
+	// == index when free, index+1 once posted
+	atomic_size_t sequence;
+
+	cxa_runLoop_cb_update_t cb;
+	void *userVar;
+}cxa_runLoop_postEntry_t;
+#endif
+
+
+/**
+ * @private
+ */
+struct cxa_runLoop
+{
+	cxa_array_t entries;
+	cxa_runLoop_entry_t entries_raw[CXA_RUN_LOOP_MAX_NUM_ENTRIES];
+
+	uint32_t backgroundBudget_us;
+	size_t nextBackgroundIndex;
+
+	// entries removed while iterating are cleared (cb == NULL) then
+	// removed once the iteration completes
+	bool isIterating;
+	bool hasClearedEntries;
+
+	// set when an entry needs to be called again promptly (no idling)
+	bool hasMoreWork;
+
+	cxa_timerWheel_t timerWheel;
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	cxa_runLoop_postEntry_t postQueue[CXA_RUNLOOP_POST_QUEUE_SIZE];
+	atomic_size_t postQueue_enqueueIndex;
+	size_t postQueue_dequeueIndex;
+
+	// may be set while other threads are posting
+	_Atomic(cxa_runLoop_cb_wake_t) cb_wake;
+	void* wakeUserVar;
+#endif
+
+	cxa_timeDiff_t td_printInfo;
+	uint32_t averageIterPeriod_us;
+};
+
+
 // ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes a new (empty) run loop. Not needed for the default
+ * run loop, which is initialized on first use.
+ *
+ * @param[in] rlIn pointer to a pre-allocated run loop
+ */
+void cxa_runLoop_init(cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @brief Returns the default run loop (used by all functions which do
+ * not explicitly take a run loop)
+ *
+ * @return the default run loop
+ */
+cxa_runLoop_t* cxa_runLoop_getDefault(void);
+
 void cxa_runLoop_addEntry(cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Adds an entry to the run loop with the given priority.
+ * ::cxa_runLoop_addEntry is equivalent to CXA_RUNLOOP_PRIORITY_NORMAL.
+ *
+ * @param[in] cbIn the callback to call
+ * @param[in] userVarIn user variable passed to the callback
+ * @param[in] priorityIn the priority of the entry
+ */
+void cxa_runLoop_addEntry_withPriority(cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn);
+
+/**
+ * @public
+ * @brief Adds an event-driven entry (CXA_RUNLOOP_PRIORITY_NORMAL) to the run loop.
+ * Like all entries, it is called on every iteration, but unlike polled entries,
+ * it does not keep the run loop from idling. It must call ::cxa_runLoop_signalMoreWork
+ * whenever it needs to be called again promptly.
+ *
+ * @param[in] cbIn the callback to call
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_runLoop_addEntry_eventDriven(cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+
 void cxa_runLoop_removeEntry(cxa_runLoop_cb_update_t cbIn);
+
+/**
+ * @public
+ * @brief Removes the entry with the given callback _and_ user variable
+ * (for callbacks which are registered multiple times with different user
+ * variables). Safe to call from within any entry's callback.
+ *
+ * @param[in] cbIn the callback of the entry to remove
+ * @param[in] userVarIn the user variable of the entry to remove
+ */
+void cxa_runLoop_removeEntry_withUserVar(cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+
 void cxa_runLoop_clearAllEntries(void);
 
+/**
+ * @public
+ * @brief Returns the number of entries currently registered with
+ * the run loop (each of which is called on every iteration).
+ *
+ * @return the number of registered entries
+ */
+size_t cxa_runLoop_getNumEntries(void);
+
+/**
+ * @public
+ * @brief Sets the amount of time, per iteration, that may be spent calling
+ * CXA_RUNLOOP_PRIORITY_BACKGROUND entries. Once the budget is used up (or the
+ * remaining budget is less than an entry's average run time) the remaining
+ * background entries are deferred to the next iteration. At least one background
+ * entry is called each iteration, so background work always makes progress.
+ *
+ * @param[in] budget_usIn the budget, in microseconds (0 for unlimited)
+ */
+void cxa_runLoop_setBackgroundBudget_us(uint32_t budget_usIn);
+
+/**
+ * @public
+ * @brief Indicates that the calling entry has more work to do, so the run
+ * loop should not idle before its next iteration. Cheap enough to call on
+ * every iteration. Must be called from the run loop's own thread (use
+ * ::cxa_runLoop_post from other threads).
+ */
+void cxa_runLoop_signalMoreWork(void);
+
 void cxa_runLoop_iterate(void);
 void cxa_runLoop_execute(void);
 
 
+/**
+ * @public
+ * @brief Equivalent to the functions above, for the given run loop
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ */
+void cxa_runLoop_instance_addEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+void cxa_runLoop_instance_addEntry_withPriority(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn);
+void cxa_runLoop_instance_addEntry_eventDriven(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+void cxa_runLoop_instance_removeEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn);
+void cxa_runLoop_instance_removeEntry_withUserVar(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+void cxa_runLoop_instance_clearAllEntries(cxa_runLoop_t *const rlIn);
+size_t cxa_runLoop_instance_getNumEntries(cxa_runLoop_t *const rlIn);
+void cxa_runLoop_instance_setBackgroundBudget_us(cxa_runLoop_t *const rlIn, uint32_t budget_usIn);
+void cxa_runLoop_instance_signalMoreWork(cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @brief Determines whether any entry signalled more work (see
+ * ::cxa_runLoop_signalMoreWork) during the last iteration. Event-driven
+ * run loops use this to decide whether they may sleep.
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ *
+ * @return true if the run loop should not idle before its next iteration
+ */
+bool cxa_runLoop_instance_hasMoreWork(cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @brief Determines whether the run loop may sleep (until its next timer,
+ * posted work or another event) before its next iteration. This is only the
+ * case when no entry signalled more work during the last iteration and all
+ * entries are event-driven (see ::cxa_runLoop_addEntry_eventDriven).
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ *
+ * @return true if the run loop may idle before its next iteration
+ */
+bool cxa_runLoop_instance_canIdle(cxa_runLoop_t *const rlIn);
+void cxa_runLoop_instance_iterate(cxa_runLoop_t *const rlIn);
+void cxa_runLoop_instance_execute(cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @brief Returns the timer wheel which services the timers bound to the
+ * given run loop (see ::cxa_timer_init_withRunLoop)
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ *
+ * @return the run loop's timer wheel
+ */
+cxa_timerWheel_t* cxa_runLoop_instance_getTimerWheel(cxa_runLoop_t *const rlIn);
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+/**
+ * @public
+ * @brief Queues a callback to be called, once, at the start of the default run
+ * loop's next iteration. Safe to call from any thread or signal handler
+ * (provided the default run loop has already been used by its own thread).
+ *
+ * @param[in] cbIn the callback to call
+ * @param[in] userVarIn user variable passed to the callback
+ *
+ * @return true if queued, false if the queue is full
+ * 		(see CXA_RUNLOOP_POST_QUEUE_SIZE) or cbIn is NULL
+ */
+bool cxa_runLoop_post(cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+
+
+/**
+ * @public
+ * @brief Equivalent to ::cxa_runLoop_post, for the given run loop
+ * (also returns false if rlIn is NULL)
+ */
+bool cxa_runLoop_instance_post(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn);
+
+
+/**
+ * @public
+ * @brief Sets the callback used to wake the run loop when work is posted
+ * (eg. by writing to an eventfd the run loop is waiting on). Event-driven
+ * run loops call this when they are initialized.
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ * @param[in] cbIn the callback (NULL for none)
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_runLoop_instance_setWakeCb(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_wake_t cbIn, void *const userVarIn);
+#endif
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+/**
+ * @public
+ * @brief Retrieves the execution statistics for the default run loop's entry
+ * at the given index (0 to ::cxa_runLoop_getNumEntries - 1)
+ *
+ * @param[in] indexIn index of the entry
+ * @param[out] profileOut the statistics for the entry
+ *
+ * @return true on success, false if the index is invalid
+ */
+bool cxa_runLoop_profiler_getProfile(size_t indexIn, cxa_runLoop_profile_t *const profileOut);
+
+
+/**
+ * @public
+ * @brief Clears the execution statistics of all of the default run loop's entries
+ */
+void cxa_runLoop_profiler_reset(void);
+
+
+/**
+ * @public
+ * @brief Writes a human-readable table of the execution statistics of
+ * all of the default run loop's entries to the given ioStream
+ *
+ * @param[in] ioStreamIn the ioStream to which the report should be written
+ */
+void cxa_runLoop_profiler_writeReport(cxa_ioStream_t *const ioStreamIn);
+
+
+/**
+ * @public
+ * @brief Equivalent to the profiler functions above, for the given run loop
+ *
+ * @param[in] rlIn pointer to a pre-initialized run loop
+ */
+bool cxa_runLoop_instance_profiler_getProfile(cxa_runLoop_t *const rlIn, size_t indexIn, cxa_runLoop_profile_t *const profileOut);
+void cxa_runLoop_instance_profiler_reset(cxa_runLoop_t *const rlIn);
+void cxa_runLoop_instance_profiler_writeReport(cxa_runLoop_t *const rlIn, cxa_ioStream_t *const ioStreamIn);
+
+
+#ifdef CXA_CONSOLE_ENABLE
+/**
+ * @public
+ * @brief Adds the 'runLoop.profile' command to the console. The command
+ * prints the profiler report for the default run loop (or clears the statistics,
+ * when called with the 'reset' argument). Must be called after ::cxa_console_init.
+ */
+void cxa_runLoop_profiler_addConsoleCommand(void);
+#endif
+#endif
+
+
 #endif // CXA_RUN_LOOP_H_
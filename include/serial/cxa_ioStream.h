@@ -67,6 +67,24 @@ typedef enum
 typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const byteOut, void *const userVarIn);
 
 
+/**
+ * @public
+ * @brief Read multiple bytes from the ioStream in a single operation.
+ *
+ * Implementations should return as many bytes as are immediately
+ * available (up to maxLen_bytesIn) without blocking.
+ *
+ * @param[out] buffOut pointer to a location at which to store the received bytes
+ * @param[in] maxLen_bytesIn the maximum number of bytes to store at buffOut
+ * @param[out] numBytesReadOut the number of bytes actually stored at buffOut
+ * @param[in] userVarIn pointer to the user-supplied variable passed to
+ * 		::cxa_ioStream_bind
+ *
+ * @return the return status of the read (GOTDATA if numBytesReadOut > 0)
+ */
+typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readBytes_t)(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+
+
 /**
  * @public
  * @brief Write bytes to the ioStream.
@@ -85,10 +103,43 @@ typedef cxa_ioStream_readStatus_t (*cxa_ioStream_cb_readByte_t)(uint8_t *const b
 typedef bool (*cxa_ioStream_cb_writeBytes_t)(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
+/**
+ * @public
+ * A single buffer within a gather-write (see ::cxa_ioStream_writeVector)
+ */
+typedef struct
+{
+	void* buff;
+	size_t size_bytes;
+}cxa_ioStream_vector_t;
+
+
+/**
+ * @public
+ * @brief Write multiple (non-contiguous) buffers to the ioStream as a single
+ * operation (ie. a single syscall, packet, or record for the underlying stream).
+ *
+ * @param[in] vectorsIn array of buffers which should be written, in order
+ * @param[in] numVectorsIn the number of buffers in vectorsIn
+ * @param[in] userVarIn pointer to the user-supplied variable passed to
+ * 		::cxa_ioStream_bind
+ *
+ * @return true if all bytes were sent / queued to be sent, false if there
+ * 		was an error with the underlying ioStream (same semantics as
+ * 		::cxa_ioStream_cb_writeBytes_t)
+ */
+typedef bool (*cxa_ioStream_cb_writeVector_t)(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn);
+
+
 struct cxa_ioStream
 {
 	cxa_ioStream_cb_readByte_t readCb;
+	cxa_ioStream_cb_readBytes_t readBytesCb;
 	cxa_ioStream_cb_writeBytes_t writeCb;
+	cxa_ioStream_cb_writeVector_t writeVectorCb;
+
+	// set when the underlying stream wakes its run loop as data arrives
+	bool signalsReadable;
 
 	void *userVar;
 };
@@ -98,16 +149,101 @@ struct cxa_ioStream
 void cxa_ioStream_init(cxa_ioStream_t *const ioStreamIn);
 
 void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByte_t readCbIn, cxa_ioStream_cb_writeBytes_t writeCbIn, void *const userVarIn);
+
+/**
+ * @public
+ * @brief Binds an (optional) bulk read callback to an already-bound ioStream.
+ *
+ * Must be called _after_ ::cxa_ioStream_bind (which clears any previously
+ * bound bulk read callback). If no bulk read callback is bound,
+ * ::cxa_ioStream_readBytes will fall back to repeated calls of the
+ * single-byte read callback.
+ *
+ * @param[in] ioStreamIn pointer to the pre-bound ioStream
+ * @param[in] readBytesCbIn the bulk read callback (may be NULL)
+ */
+void cxa_ioStream_bind_readBytes(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn);
+
+/**
+ * @public
+ * @brief Binds an (optional) gather-write callback to an already-bound ioStream.
+ *
+ * Must be called _after_ ::cxa_ioStream_bind (which clears any previously
+ * bound gather-write callback). If no gather-write callback is bound,
+ * ::cxa_ioStream_writeVector will fall back to sequential calls of the
+ * write callback.
+ *
+ * @param[in] ioStreamIn pointer to the pre-bound ioStream
+ * @param[in] writeVectorCbIn the gather-write callback (may be NULL)
+ */
+void cxa_ioStream_bind_writeVector(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_writeVector_t writeVectorCbIn);
+
+/**
+ * @public
+ * @brief Indicates whether the underlying implementation signals its run loop
+ * (see ::cxa_runLoop_signalMoreWork) whenever new data becomes available to read.
+ * Readers serviced by that run loop may then wait for data (rather than polling).
+ *
+ * Must be called _after_ ::cxa_ioStream_bind (which clears this flag). May change at
+ * any time (eg. once the implementation is serviced by an event-driven run loop), so
+ * readers should re-check it rather than caching it.
+ *
+ * @param[in] ioStreamIn pointer to the pre-bound ioStream
+ * @param[in] signalsReadableIn true if the implementation signals when readable
+ */
+void cxa_ioStream_bind_signalsReadable(cxa_ioStream_t *const ioStreamIn, bool signalsReadableIn);
+
+/**
+ * @public
+ * @brief Determines whether the underlying implementation signals its run loop
+ * whenever new data becomes available (see ::cxa_ioStream_bind_signalsReadable)
+ *
+ * @param[in] ioStreamIn pointer to the pre-initialized ioStream
+ *
+ * @return true if readers may wait for a signal rather than polling
+ */
+bool cxa_ioStream_signalsReadable(cxa_ioStream_t *const ioStreamIn);
 void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn);
 bool cxa_ioStream_isBound(cxa_ioStream_t *const ioStreamIn);
 
 cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn, uint8_t *const byteOut);
+
+/**
+ * @public
+ * @brief Reads as many bytes as are immediately available (up to maxLen_bytesIn)
+ *
+ * @param[in] ioStreamIn pointer to the pre-initialized ioStream
+ * @param[out] buffOut pointer to a location at which to store the received bytes
+ * @param[in] maxLen_bytesIn the maximum number of bytes to store at buffOut
+ * @param[out] numBytesReadOut the number of bytes actually stored at buffOut (may be NULL)
+ *
+ * @return GOTDATA if at least one byte was read, NODATA if no bytes were
+ * 		available, ERROR if an error occurred before any bytes were read.
+ * 		If an error occurs after some bytes were read, GOTDATA is returned
+ * 		and the error will be reported on the next read.
+ */
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut);
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn);
 
 void cxa_ioStream_clearReadBuffer(cxa_ioStream_t *const ioStreamIn);
 
 bool cxa_ioStream_writeByte(cxa_ioStream_t *const ioStreamIn, uint8_t byteIn);
 bool cxa_ioStream_writeBytes(cxa_ioStream_t *const ioStreamIn, void* buffIn, size_t bufferSize_bytesIn);
+
+/**
+ * @public
+ * @brief Writes multiple (non-contiguous) buffers, in order, as a single
+ * operation if the underlying ioStream supports it.
+ *
+ * @param[in] ioStreamIn pointer to the pre-initialized ioStream
+ * @param[in] vectorsIn array of buffers to write (zero-length entries are allowed)
+ * @param[in] numVectorsIn the number of entries in vectorsIn
+ *
+ * @return true if all bytes were sent / queued to be sent. If false, implementations
+ * 		should have sent / queued none of the bytes (so the write may be retried), or
+ * 		report an error on every subsequent write.
+ */
+bool cxa_ioStream_writeVector(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn);
 bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const fbbIn);
 bool cxa_ioStream_writeString(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
 bool cxa_ioStream_writeLine(cxa_ioStream_t *const ioStreamIn, const char* stringIn);
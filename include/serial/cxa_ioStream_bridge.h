@@ -23,20 +23,73 @@
 
 
 // ******** global macro definitions ********
+#ifndef CXA_IOSTREAM_BRIDGE_BUFFER_SIZE_BYTES
+	#define CXA_IOSTREAM_BRIDGE_BUFFER_SIZE_BYTES				64
+#endif
+
+#ifndef CXA_IOSTREAM_BRIDGE_DEFAULT_MAXNUM_BYTES_PER_UPDATE
+	#define CXA_IOSTREAM_BRIDGE_DEFAULT_MAXNUM_BYTES_PER_UPDATE	512
+#endif
 
 
 // ******** global type definitions *********
+/**
+ * @private
+ * Bytes which have been read from one stream but not yet
+ * accepted by the other
+ */
+typedef struct
+{
+	uint8_t buffer[CXA_IOSTREAM_BRIDGE_BUFFER_SIZE_BYTES];
+	size_t numBytesPending;
+}cxa_ioStream_bridge_stagingBuffer_t;
+
+
+/**
+ * @private
+ */
 typedef struct
 {
 	cxa_ioStream_t* stream1;
 	cxa_ioStream_t* stream2;
+
+	size_t maxNumBytesPerUpdate;
+
+	cxa_ioStream_bridge_stagingBuffer_t staging_1to2;
+	cxa_ioStream_bridge_stagingBuffer_t staging_2to1;
 }cxa_ioStream_bridge_t;
 
 
 // ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes a bridge which copies all data received on one
+ * stream to the other (in both directions) from the run loop.
+ *
+ * Each direction moves up to CXA_IOSTREAM_BRIDGE_DEFAULT_MAXNUM_BYTES_PER_UPDATE
+ * bytes per run loop iteration (see ::cxa_ioStream_bridge_setMaxBytesPerUpdate).
+ * If the destination stream refuses a write, the data is retained and no
+ * further data is read from the source until the destination accepts it.
+ *
+ * @param[in] bridgeIn pointer to a pre-allocated bridge object
+ * @param[in] stream1In the first stream
+ * @param[in] stream2In the second stream
+ */
 void cxa_ioStream_bridge_init(cxa_ioStream_bridge_t *const bridgeIn,
 								cxa_ioStream_t *const stream1In,
 								cxa_ioStream_t *const stream2In);
 
 
+/**
+ * @public
+ * @brief Sets the maximum number of bytes moved in each direction
+ * during a single run loop iteration.
+ *
+ * @param[in] bridgeIn pointer to a pre-initialized bridge object
+ * @param[in] maxNumBytesIn the maximum number of bytes per direction
+ * 		per iteration (must be non-zero)
+ */
+void cxa_ioStream_bridge_setMaxBytesPerUpdate(cxa_ioStream_bridge_t *const bridgeIn, size_t maxNumBytesIn);
+
+
 #endif
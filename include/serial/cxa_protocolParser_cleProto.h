@@ -31,9 +31,29 @@
 // ******** includes ********
 #include <cxa_protocolParser.h>
 #include <cxa_stateMachine.h>
+#include <cxa_timer.h>
 
 
 // ******** global macro definitions ********
+/**
+ * @public
+ * Maximum number of bytes the parser will consume from its ioStream during
+ * a single run loop update.
+ */
+#ifndef CXA_PROTOCOLPARSER_CLEPROTO_MAXNUM_RX_BYTES_PER_UPDATE
+	#define CXA_PROTOCOLPARSER_CLEPROTO_MAXNUM_RX_BYTES_PER_UPDATE		256
+#endif
+
+/**
+ * @public
+ * Size of the block used to read bytes from the ioStream. Each block is parsed
+ * in its entirety (possibly spanning several frames) before the next is read.
+ * If a listener moves the parser mid-block (eg. to idle), the rest of the block
+ * is kept and parsed once the parser is receiving again.
+ */
+#ifndef CXA_PROTOCOLPARSER_CLEPROTO_RX_CHUNK_SIZE_BYTES
+	#define CXA_PROTOCOLPARSER_CLEPROTO_RX_CHUNK_SIZE_BYTES				64
+#endif
 
 
 // ******** global type definitions *********
@@ -45,11 +65,25 @@ struct cxa_protocolParser_cleProto
 	cxa_protocolParser_t super;
 
 	cxa_stateMachine_t stateMachine;
+
+	cxa_timer_t timer_receptionTimeout;
+
+	uint8_t rxChunk[CXA_PROTOCOLPARSER_CLEPROTO_RX_CHUNK_SIZE_BYTES];
+	size_t rxChunk_startIndex;
+	size_t rxChunk_endIndex;
 };
 
 
 // ******** global function prototypes ********
 void cxa_protocolParser_cleProto_init(cxa_protocolParser_cleProto_t *const clePpIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn);
 
+/**
+ * @public
+ * @brief Same as ::cxa_protocolParser_cleProto_init, but the parser is
+ * executed by the given run loop (rather than the default run loop)
+ */
+void cxa_protocolParser_cleProto_init_withRunLoop(cxa_protocolParser_cleProto_t *const clePpIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
+												  cxa_runLoop_t *const rlIn);
+
 
 #endif /* CXA_PROTOCOLPARSER_CLE_H_ */
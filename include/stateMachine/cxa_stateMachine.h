@@ -20,6 +20,21 @@
 /**
  * @file <description>
  *
+ * States are looked up through a table indexed by state id, so state ids
+ * should be small and non-negative (0 to CXA_STATE_MACHINE_MAX_NUM_STATES-1,
+ * eg. an enum). Other ids still work, but are looked up by searching.
+ *
+ * While a state machine sits in a state with no 'state' callback it is removed
+ * from the run loop, so idle state machines cost nothing per iteration. It is
+ * re-added on the next transition. Timed states are expired by a timer (see
+ * @ref cxa_timer.h) serviced by the state machine's run loop, so they too cost
+ * nothing until their timeout is due.
+ *
+ * By default, state callbacks are polled (so the run loop will not idle while the
+ * state machine is in a state with a 'state' callback). State machines whose state
+ * callbacks only have work to do after some event (eg. data arriving, a timer
+ * expiring) may be marked as event-driven (see ::cxa_stateMachine_setEventDriven).
+ *
  * Configuration Options:
  *		CXA_STATE_MACHINE_MAX_NUM_STATES
  *		CXA_STATE_MACHINE_ENABLE_LOGGING
@@ -32,13 +47,14 @@
 // ******** includes ********
 #include <stdint.h>
 #include <cxa_array.h>
+#include <cxa_runLoop.h>
 
 #include <cxa_config.h>
 #ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 	#include <cxa_logger_header.h>
 #endif
 #ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-	#include <cxa_timeDiff.h>
+	#include <cxa_timer.h>
 #endif
 
 
@@ -109,6 +125,11 @@ struct cxa_stateMachine
 	
 	cxa_array_t states;
 	cxa_stateMachine_state_t states_raw[CXA_STATE_MACHINE_MAX_NUM_STATES];
+	cxa_stateMachine_state_t* states_byId[CXA_STATE_MACHINE_MAX_NUM_STATES];
+
+	cxa_runLoop_t* runLoop;
+	bool isInRunLoop;
+	bool isEventDriven;
 	
 	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
 		cxa_logger_t logger;
@@ -116,7 +137,7 @@ struct cxa_stateMachine
 	
 	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
 		bool timedStatesEnabled;
-		cxa_timeDiff_t td_timedTransition;
+		cxa_timer_t timer_timedTransition;
 	#endif
 };
 
@@ -124,6 +145,31 @@ struct cxa_stateMachine
 // ******** global function prototypes ********
 void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn);
 
+/**
+ * @public
+ * @brief Initializes the state machine so that it is executed by the given
+ * run loop (rather than the default run loop)
+ *
+ * @param[in] smIn pointer to a pre-allocated state machine
+ * @param[in] nameIn name of the state machine (for logging)
+ * @param[in] rlIn the run loop which will execute this state machine
+ */
+void cxa_stateMachine_init_withRunLoop(cxa_stateMachine_t *const smIn, const char* nameIn, cxa_runLoop_t *const rlIn);
+
+/**
+ * @public
+ * @brief Determines whether the state machine's state callbacks are polled
+ * (the default) or event-driven. Event-driven state callbacks are still called
+ * on every iteration of the run loop, but do not keep it from idling (see
+ * ::cxa_runLoop_addEntry_eventDriven). They must call ::cxa_runLoop_instance_signalMoreWork
+ * (or arrange for a timer / other event to wake the run loop) whenever they need to be
+ * called again promptly.
+ *
+ * @param[in] smIn pointer to a pre-initialized state machine
+ * @param[in] isEventDrivenIn true if the state callbacks are event-driven
+ */
+void cxa_stateMachine_setEventDriven(cxa_stateMachine_t *const smIn, bool isEventDrivenIn);
+
 void cxa_stateMachine_addState(cxa_stateMachine_t *const smIn, int idIn, const char* nameIn,
 	cxa_stateMachine_cb_enter_t cb_enterIn, cxa_stateMachine_cb_state_t cb_stateIn, cxa_stateMachine_cb_leave_t cb_leaveIn,
 	void *userVarIn);
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * This file contains a 64-bit variant of the time differential (see @ref cxa_timeDiff.h).
+ * It is backed by the 64-bit nanosecond counter of the timeBase, which does not overflow
+ * in practice. Because of this, there is no overflow handling: checking for elapsed time
+ * is a single subtraction and comparison, and arbitrarily long periods can be measured.
+ *
+ * @note Only available on architectures which implement ::cxa_timeBase_getCount64_ns
+ * 		(currently POSIX)
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * cxa_timeDiff64_t td_keepAlive;
+ * cxa_timeDiff64_init(&td_keepAlive);
+ *
+ * ...
+ *
+ * while(true)
+ * {
+ *    if( cxa_timeDiff64_isElapsed_recurring_ms(&td_keepAlive, 30000) )
+ *    {
+ *       // send a keepalive
+ *    }
+ * }
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_TIMEDIFF64_H_
+#define CXA_TIMEDIFF64_H_
+
+
+// ******** includes ********
+#include <stdint.h>
+#include <stdbool.h>
+#include <cxa_timeBase.h>
+
+
+// ******** global macro definitions ********
+
+
+// ******** global type definitions *********
+typedef struct
+{
+	uint64_t startTime_ns;
+}cxa_timeDiff64_t;
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes the timeDiff using the reference timeBase
+ *
+ * @param[in] tdIn the pre-allocated timeDiff object
+ */
+void cxa_timeDiff64_init(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ * @brief Sets the "startTime" of the timeDiff to the current value of the
+ * reference timeBase
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ */
+void cxa_timeDiff64_setStartTime_now(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ *
+ * @return the amount of time (in nanoseconds) since a call to
+ * 		setStartTime_now
+ */
+uint64_t cxa_timeDiff64_getElapsedTime_ns(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ *
+ * @return the amount of time (in milliseconds) since a call to
+ * 		setStartTime_now
+ */
+uint64_t cxa_timeDiff64_getElapsedTime_ms(cxa_timeDiff64_t *const tdIn);
+
+/**
+ * @public
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ * @param[in] msIn the desired number of milliseconds
+ *
+ * @return true if the specified amount of time has elapsed since the last
+ * 		call to setStartTime_now. Once true is returned, this timeDiff
+ * 		will return true until setStartTime_now is called again.
+ */
+bool cxa_timeDiff64_isElapsed_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn);
+
+/**
+ * @public
+ * This is a convenience method which combines calls to isElapsed_ms and
+ * setStartTime_now.
+ *
+ * @param[in] tdIn the pre-initialized timeDiff
+ * @param[in] msIn the desired number of milliseconds
+ *
+ * @return true if the specified amount of time has elapsed since the last
+ * 		call to setStartTime_now. Once true is returned, this function will
+ * 		automatically call setStartTime_now.
+ */
+bool cxa_timeDiff64_isElapsed_recurring_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn);
+
+
+#endif // CXA_TIMEDIFF64_H_
@@ -0,0 +1,245 @@
+/**
+ * @file
+ * This file contains one-shot and periodic software timers, serviced by the
+ * run loop. Instead of polling a ::cxa_timeDiff_t on every iteration, a module
+ * arms a timer and is called back once it expires.
+ *
+ * Timers are kept in a hierarchical timer wheel: arming, stopping and expiring
+ * a timer are all O(1), regardless of how many timers are running. Timers have
+ * a resolution of 1 millisecond and are guaranteed to expire no _earlier_ than
+ * requested (they may expire later if the run loop is busy).
+ *
+ * Each run loop owns a timer wheel, which is updated automatically on every iteration.
+ * Timers are serviced by the default run loop unless initialized with
+ * ::cxa_timer_init_withRunLoop. Event-driven run loops can use
+ * ::cxa_timerWheel_getTimeUntilNextDeadline_ms to determine how long they may sleep.
+ *
+ * @note This object should work across all architecture-specific implementations
+ *
+ *
+ * #### Example Usage: ####
+ *
+ * @code
+ * static void onBlink(cxa_timer_t *const timerIn, void* userVarIn)
+ * {
+ *    // blink an LED
+ * }
+ *
+ * cxa_timer_t timer_blink;
+ * cxa_timer_init(&timer_blink, onBlink, NULL);
+ * cxa_timer_startPeriodic_ms(&timer_blink, 100);
+ *
+ * cxa_runLoop_execute();
+ * @endcode
+ *
+ *
+ * @copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @author Christopher Armenio
+ */
+#ifndef CXA_TIMER_H_
+#define CXA_TIMER_H_
+
+
+// ******** includes ********
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+// ******** global macro definitions ********
+/**
+ * Number of levels in the timer wheel. Each level has 64 slots, so
+ * the wheel spans 2^(6 * levels) milliseconds. Timers longer than the
+ * span still work, but are re-inserted each time they reach the end
+ * of the wheel.
+ */
+#ifndef CXA_TIMER_WHEEL_NUM_LEVELS
+	#define CXA_TIMER_WHEEL_NUM_LEVELS					4
+#endif
+
+#define CXA_TIMER_WHEEL_SLOT_BITS						6
+
+
+// ******** global type definitions *********
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_timer_t object
+ */
+typedef struct cxa_timer cxa_timer_t;
+
+
+/**
+ * @public
+ * @brief "Forward" declaration of the cxa_runLoop_t object (see @ref cxa_runLoop.h)
+ */
+struct cxa_runLoop;
+
+
+/**
+ * @public
+ * @brief Called when a timer expires
+ *
+ * @param[in] timerIn the timer which expired
+ * @param[in] userVarIn the user variable passed to ::cxa_timer_init
+ */
+typedef void (*cxa_timer_cb_onExpire_t)(cxa_timer_t *const timerIn, void* userVarIn);
+
+
+/**
+ * @private
+ */
+typedef struct
+{
+	cxa_timer_t* slots[CXA_TIMER_WHEEL_NUM_LEVELS][1 << CXA_TIMER_WHEEL_SLOT_BITS];
+	size_t numTimersPerLevel[CXA_TIMER_WHEEL_NUM_LEVELS];
+	size_t numTimers;
+
+	// time, in ticks (ms), according to the timeBase
+	uint32_t clockTick;
+	uint32_t lastCount_us;
+	uint32_t subTick_us;
+
+	// the tick that has most recently been processed
+	uint32_t currTick;
+}cxa_timerWheel_t;
+
+
+/**
+ * @private
+ */
+struct cxa_timer
+{
+	cxa_timerWheel_t* wheel;
+
+	cxa_timer_t* next;
+	cxa_timer_t** pprev;
+	uint8_t level;
+
+	uint32_t expiry_ticks;
+	uint32_t period_ms;
+
+	cxa_timer_cb_onExpire_t cb;
+	void* userVar;
+};
+
+
+// ******** global function prototypes ********
+/**
+ * @public
+ * @brief Initializes a (stopped) timer, serviced by the default run loop
+ *
+ * @param[in] timerIn pointer to a pre-allocated timer
+ * @param[in] cbIn callback to be called when the timer expires
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_timer_init(cxa_timer_t *const timerIn, cxa_timer_cb_onExpire_t cbIn, void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Initializes a (stopped) timer, serviced by the given run loop. The
+ * timer's callback is called from that run loop and the timer should only be
+ * started/stopped from that run loop's thread.
+ *
+ * @param[in] timerIn pointer to a pre-allocated timer
+ * @param[in] rlIn the run loop which will service the timer
+ * @param[in] cbIn callback to be called when the timer expires
+ * @param[in] userVarIn user variable passed to the callback
+ */
+void cxa_timer_init_withRunLoop(cxa_timer_t *const timerIn, struct cxa_runLoop *const rlIn, cxa_timer_cb_onExpire_t cbIn, void* userVarIn);
+
+
+/**
+ * @public
+ * @brief Starts the timer so that it expires once, the given number
+ * of milliseconds from now. Restarts the timer if it is already running.
+ *
+ * @param[in] timerIn pointer to a pre-initialized timer
+ * @param[in] delay_msIn the delay, in milliseconds (must be less than 2^31)
+ */
+void cxa_timer_startOneShot_ms(cxa_timer_t *const timerIn, uint32_t delay_msIn);
+
+
+/**
+ * @public
+ * @brief Starts the timer so that it expires every period_msIn milliseconds.
+ * Periods are measured from the previous expiration (not from the callback)
+ * so the timer does not drift. Restarts the timer if it is already running.
+ *
+ * @param[in] timerIn pointer to a pre-initialized timer
+ * @param[in] period_msIn the period, in milliseconds (must be non-zero and
+ * 		less than 2^31)
+ */
+void cxa_timer_startPeriodic_ms(cxa_timer_t *const timerIn, uint32_t period_msIn);
+
+
+/**
+ * @public
+ * @brief Stops the timer (if running). Safe to call from within any
+ * timer's callback.
+ *
+ * @param[in] timerIn pointer to a pre-initialized timer
+ */
+void cxa_timer_stop(cxa_timer_t *const timerIn);
+
+
+/**
+ * @public
+ * @brief Determines whether the timer is currently running
+ *
+ * @param[in] timerIn pointer to a pre-initialized timer
+ *
+ * @return true if the timer is running
+ */
+bool cxa_timer_isRunning(cxa_timer_t *const timerIn);
+
+
+/**
+ * @public
+ * @brief Initializes an (empty) timer wheel. Run loops initialize their
+ * own timer wheel, so it is not normally necessary to call this directly.
+ *
+ * @param[in] wheelIn pointer to a pre-allocated timer wheel
+ */
+void cxa_timerWheel_init(cxa_timerWheel_t *const wheelIn);
+
+
+/**
+ * @public
+ * @brief Returns the time until the next timer needs servicing. The returned
+ * value may be earlier than the actual expiration of the next timer (when
+ * timers are migrated between levels of the wheel) but will never be later.
+ *
+ * @param[in] wheelIn pointer to a pre-initialized timer wheel
+ * @param[out] time_msOut the number of milliseconds until ::cxa_timerWheel_update
+ * 		should next be called (0 if it should be called now)
+ *
+ * @return true if any timers are running, false if there are none (in which
+ * 		case time_msOut is not modified)
+ */
+bool cxa_timerWheel_getTimeUntilNextDeadline_ms(cxa_timerWheel_t *const wheelIn, uint32_t *const time_msOut);
+
+
+/**
+ * @public
+ * @brief Expires any timers whose time has come, calling their callbacks.
+ * This is called by the owning run loop on every iteration, so it is not
+ * normally necessary to call it directly.
+ *
+ * @param[in] wheelIn pointer to a pre-initialized timer wheel
+ */
+void cxa_timerWheel_update(cxa_timerWheel_t *const wheelIn);
+
+
+#endif // CXA_TIMER_H_
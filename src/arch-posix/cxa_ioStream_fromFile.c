@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <cxa_assert.h>
 
 #include <termios.h>
@@ -41,12 +42,21 @@
 
 // ******** local function prototypes ********
 static bool set_blocking(cxa_ioStream_fromFile_t *const ioStreamIn, bool should_block);
+static cxa_ioStream_readStatus_t fillReadBuffer(cxa_ioStream_fromFile_t *const ioStreamIn);
+static bool writeToFile(cxa_ioStream_fromFile_t *const ioStreamIn, uint8_t *const buffIn, size_t numBytesIn, size_t *const numBytesWrittenOut);
+static void unlinkOpenStream(cxa_ioStream_fromFile_t *const ioStreamIn);
+static void flushOpenStreams(void);
 
 static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool writeVector_cb(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
+static bool isAtExitRegistered = false;
+// streams stay linked here until closed (which is why closing is mandatory)
+static cxa_ioStream_fromFile_t* openStreams = NULL;
 
 
 // ******** global function implementations ********
@@ -57,20 +67,59 @@ void cxa_ioStream_fromFile_init(cxa_ioStream_fromFile_t *const ioStreamIn, FILE
 
 	// save our internal state
 	ioStreamIn->file = fileIn;
+	ioStreamIn->readBuffer_startIndex = 0;
+	ioStreamIn->readBuffer_endIndex = 0;
+	ioStreamIn->writeBuffer_len = 0;
+
+	// like stdio, interactive output is written at the end of each line
+	ioStreamIn->isLineBuffered = isatty(fileno(fileIn));
+
+	// buffered output (eg. an assert message) should make it out on exit
+	unlinkOpenStream(ioStreamIn);
+	ioStreamIn->nextOpenStream = openStreams;
+	openStreams = ioStreamIn;
+	if( !isAtExitRegistered ) isAtExitRegistered = (atexit(flushOpenStreams) == 0);
 
 	// initialize our super class
 	cxa_ioStream_init(&ioStreamIn->super);
 	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
+	cxa_ioStream_bind_writeVector(&ioStreamIn->super, writeVector_cb);
 
 	// make our file non-blocking
 	set_blocking(ioStreamIn, true);
 }
 
 
+bool cxa_ioStream_fromFile_flush(cxa_ioStream_fromFile_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	if( ioStreamIn->writeBuffer_len == 0 ) return true;
+
+	size_t numBytesWritten = 0;
+	bool retVal = writeToFile(ioStreamIn, ioStreamIn->writeBuffer, ioStreamIn->writeBuffer_len, &numBytesWritten);
+
+	// keep anything that didn't make it out
+	if( numBytesWritten < ioStreamIn->writeBuffer_len )
+	{
+		memmove(ioStreamIn->writeBuffer, &ioStreamIn->writeBuffer[numBytesWritten], ioStreamIn->writeBuffer_len - numBytesWritten);
+	}
+	ioStreamIn->writeBuffer_len -= numBytesWritten;
+
+	return retVal && (ioStreamIn->writeBuffer_len == 0);
+}
+
+
 void cxa_ioStream_fromFile_close(cxa_ioStream_fromFile_t *const ioStreamIn)
 {
 	cxa_assert(ioStreamIn);
 
+	cxa_ioStream_fromFile_flush(ioStreamIn);
+	ioStreamIn->readBuffer_startIndex = 0;
+	ioStreamIn->readBuffer_endIndex = 0;
+	unlinkOpenStream(ioStreamIn);
+
 	set_blocking(ioStreamIn, false);
 }
 
@@ -96,19 +145,115 @@ static bool set_blocking(cxa_ioStream_fromFile_t *const ioStreamIn, bool should_
 }
 
 
-static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn)
+static cxa_ioStream_readStatus_t fillReadBuffer(cxa_ioStream_fromFile_t *const ioStreamIn)
 {
-	cxa_assert(userVarIn);
-	cxa_ioStream_fromFile_t* ioStreamIn = (cxa_ioStream_fromFile_t*)userVarIn;
+	cxa_assert(ioStreamIn);
 
 	int fd = fileno(ioStreamIn->file);
 	cxa_assert(fd >= 0);
 
-	// perform our read and check the return value
-	ssize_t retVal_read = read(fd, byteOut, 1);
-	if( retVal_read < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
+	// anything we've written should be out before we (potentially) wait on a response
+	cxa_ioStream_fromFile_flush(ioStreamIn);
+
+	ssize_t retVal_read = read(fd, ioStreamIn->readBuffer, sizeof(ioStreamIn->readBuffer));
+	if( retVal_read < 0 ) return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? CXA_IOSTREAM_READSTAT_NODATA : CXA_IOSTREAM_READSTAT_ERROR;
 	else if( retVal_read == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
 
+	ioStreamIn->readBuffer_startIndex = 0;
+	ioStreamIn->readBuffer_endIndex = (size_t)retVal_read;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static bool writeToFile(cxa_ioStream_fromFile_t *const ioStreamIn, uint8_t *const buffIn, size_t numBytesIn, size_t *const numBytesWrittenOut)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(numBytesWrittenOut);
+
+	int fd = fileno(ioStreamIn->file);
+	cxa_assert(fd >= 0);
+
+	// anything the user wrote to the FILE directly must precede our data
+	fflush(ioStreamIn->file);
+
+	*numBytesWrittenOut = 0;
+	while( *numBytesWrittenOut < numBytesIn )
+	{
+		ssize_t retVal_write = write(fd, &buffIn[*numBytesWrittenOut], numBytesIn - *numBytesWrittenOut);
+		if( retVal_write < 0 )
+		{
+			if( errno == EINTR ) continue;
+			return false;
+		}
+		*numBytesWrittenOut += (size_t)retVal_write;
+	}
+
+	return true;
+}
+
+
+static void unlinkOpenStream(cxa_ioStream_fromFile_t *const ioStreamIn)
+{
+	for( cxa_ioStream_fromFile_t** currLink = &openStreams; *currLink != NULL; currLink = &(*currLink)->nextOpenStream )
+	{
+		if( *currLink == ioStreamIn )
+		{
+			*currLink = ioStreamIn->nextOpenStream;
+			return;
+		}
+	}
+}
+
+
+static void flushOpenStreams(void)
+{
+	for( cxa_ioStream_fromFile_t* currStream = openStreams; currStream != NULL; currStream = currStream->nextOpenStream )
+	{
+		cxa_ioStream_fromFile_flush(currStream);
+	}
+}
+
+
+static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_fromFile_t* ioStreamIn = (cxa_ioStream_fromFile_t*)userVarIn;
+
+	if( ioStreamIn->readBuffer_startIndex == ioStreamIn->readBuffer_endIndex )
+	{
+		cxa_ioStream_readStatus_t retVal = fillReadBuffer(ioStreamIn);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) return retVal;
+	}
+
+	if( byteOut != NULL ) *byteOut = ioStreamIn->readBuffer[ioStreamIn->readBuffer_startIndex];
+	ioStreamIn->readBuffer_startIndex++;
+
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_assert(numBytesReadOut);
+	cxa_ioStream_fromFile_t* ioStreamIn = (cxa_ioStream_fromFile_t*)userVarIn;
+
+	*numBytesReadOut = 0;
+	if( maxLen_bytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	if( ioStreamIn->readBuffer_startIndex == ioStreamIn->readBuffer_endIndex )
+	{
+		cxa_ioStream_readStatus_t retVal = fillReadBuffer(ioStreamIn);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) return retVal;
+	}
+
+	size_t numBytesToCopy = ioStreamIn->readBuffer_endIndex - ioStreamIn->readBuffer_startIndex;
+	if( numBytesToCopy > maxLen_bytesIn ) numBytesToCopy = maxLen_bytesIn;
+
+	if( buffOut != NULL ) memcpy(buffOut, &ioStreamIn->readBuffer[ioStreamIn->readBuffer_startIndex], numBytesToCopy);
+	ioStreamIn->readBuffer_startIndex += numBytesToCopy;
+
+	*numBytesReadOut = numBytesToCopy;
 	return CXA_IOSTREAM_READSTAT_GOTDATA;
 }
 
@@ -119,9 +264,58 @@ static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVa
 	cxa_ioStream_fromFile_t* ioStreamIn = (cxa_ioStream_fromFile_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
+	// make room if needed
+	if( bufferSize_bytesIn > (sizeof(ioStreamIn->writeBuffer) - ioStreamIn->writeBuffer_len) )
+	{
+		if( !cxa_ioStream_fromFile_flush(ioStreamIn) ) return false;
+	}
+
+	// large writes go straight through
+	if( bufferSize_bytesIn >= sizeof(ioStreamIn->writeBuffer) )
+	{
+		size_t numBytesWritten = 0;
+		return writeToFile(ioStreamIn, (uint8_t*)buffIn, bufferSize_bytesIn, &numBytesWritten);
+	}
+
+	memcpy(&ioStreamIn->writeBuffer[ioStreamIn->writeBuffer_len], buffIn, bufferSize_bytesIn);
+	ioStreamIn->writeBuffer_len += bufferSize_bytesIn;
+
+	if( ioStreamIn->isLineBuffered && (memchr(buffIn, '\n', bufferSize_bytesIn) != NULL) ) return cxa_ioStream_fromFile_flush(ioStreamIn);
+
+	return true;
+}
+
+
+static bool writeVector_cb(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_fromFile_t* ioStreamIn = (cxa_ioStream_fromFile_t*)userVarIn;
+
+	size_t totalSize_bytes = 0;
+	for( size_t i = 0; i < numVectorsIn; i++ ) totalSize_bytes += vectorsIn[i].size_bytes;
+
+	// small enough to gather into our write buffer?
+	if( totalSize_bytes < sizeof(ioStreamIn->writeBuffer) )
+	{
+		if( (totalSize_bytes > (sizeof(ioStreamIn->writeBuffer) - ioStreamIn->writeBuffer_len)) &&
+			!cxa_ioStream_fromFile_flush(ioStreamIn) ) return false;
+
+		bool hasNewline = false;
+		for( size_t i = 0; i < numVectorsIn; i++ )
+		{
+			if( vectorsIn[i].size_bytes == 0 ) continue;
+			memcpy(&ioStreamIn->writeBuffer[ioStreamIn->writeBuffer_len], vectorsIn[i].buff, vectorsIn[i].size_bytes);
+			ioStreamIn->writeBuffer_len += vectorsIn[i].size_bytes;
+			if( ioStreamIn->isLineBuffered && !hasNewline ) hasNewline = (memchr(vectorsIn[i].buff, '\n', vectorsIn[i].size_bytes) != NULL);
+		}
+		return hasNewline ? cxa_ioStream_fromFile_flush(ioStreamIn) : true;
+	}
+
+	// too large to gather...write each piece
+	for( size_t i = 0; i < numVectorsIn; i++ )
 	{
-		fputc( (((char*)buffIn)[i]), ioStreamIn->file );
+		if( vectorsIn[i].size_bytes == 0 ) continue;
+		if( !write_cb(vectorsIn[i].buff, vectorsIn[i].size_bytes, userVarIn) ) return false;
 	}
 
 	return true;
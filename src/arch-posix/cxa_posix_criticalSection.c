@@ -0,0 +1,67 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_criticalSection.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <pthread.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void initMutex(void);
+
+
+// ********  local variable declarations *********
+// there are no interrupts to disable on posix...instead, critical sections
+// are mutually exclusive between threads (recursive, so they can be nested)
+static pthread_once_t mutex_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t mutex;
+
+
+// ******** global function implementations ********
+void cxa_criticalSection_enter(void)
+{
+	pthread_once(&mutex_once, initMutex);
+	pthread_mutex_lock(&mutex);
+}
+
+
+void cxa_criticalSection_exit(void)
+{
+	pthread_mutex_unlock(&mutex);
+}
+
+
+// ******** local function implementations ********
+static void initMutex(void)
+{
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
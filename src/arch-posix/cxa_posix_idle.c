@@ -0,0 +1,160 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define _GNU_SOURCE
+#include "cxa_posix_idle.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+	#include <sys/eventfd.h>
+#else
+	#include <fcntl.h>
+	#include <sys/select.h>
+#endif
+
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#ifndef CXA_POSIX_IDLE_MAXNUM_THREADS
+	#define CXA_POSIX_IDLE_MAXNUM_THREADS				8
+#endif
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void registerThread(void);
+
+
+// ********  local variable declarations *********
+// each idling thread waits on its own eventfd (or pipe where there is no eventfd)
+// so one thread clearing a wakeup can't cause another thread to miss it...these
+// are the ends we write to
+static pthread_mutex_t wakeFds_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int wakeFds[CXA_POSIX_IDLE_MAXNUM_THREADS];
+static atomic_size_t numWakeFds = ATOMIC_VAR_INIT(0);
+
+static __thread int thisThread_wakeFd = -1;
+static __thread sigset_t thisThread_sleepMask;
+
+
+// ******** global function implementations ********
+void cxa_idle_sleep_ms(uint32_t maxSleep_msIn)
+{
+	if( thisThread_wakeFd < 0 ) registerThread();
+
+	struct timespec timeout = {.tv_sec=maxSleep_msIn / 1000, .tv_nsec=(maxSleep_msIn % 1000) * 1000000L};
+
+#ifdef __linux__
+	struct pollfd pfd = {.fd=thisThread_wakeFd, .events=POLLIN};
+
+	// returns early (EINTR) if a signal is caught (including those only unblocked while sleeping)
+	if( ppoll(&pfd, 1, (maxSleep_msIn == CXA_IDLE_FOREVER) ? NULL : &timeout, &thisThread_sleepMask) > 0 )
+	{
+		// clear the wakeup
+		uint64_t val;
+		while( (read(thisThread_wakeFd, &val, sizeof(val)) < 0) && (errno == EINTR) );
+	}
+#else
+	fd_set readFds;
+	FD_ZERO(&readFds);
+	FD_SET(thisThread_wakeFd, &readFds);
+
+	// returns early (EINTR) if a signal is caught (including those only unblocked while sleeping)
+	if( pselect(thisThread_wakeFd+1, &readFds, NULL, NULL, (maxSleep_msIn == CXA_IDLE_FOREVER) ? NULL : &timeout, &thisThread_sleepMask) > 0 )
+	{
+		// clear the wakeup (there may be several bytes queued)
+		uint8_t buff[16];
+		while( (read(thisThread_wakeFd, buff, sizeof(buff)) > 0) || (errno == EINTR) );
+	}
+#endif
+}
+
+
+void cxa_idle_wake(void)
+{
+	// async-signal-safe...only atomics and write
+	size_t numFds = atomic_load_explicit(&numWakeFds, memory_order_acquire);
+	for( size_t i = 0; i < numFds; i++ )
+	{
+#ifdef __linux__
+		uint64_t val = 1;
+#else
+		// a full pipe is fine (it is already awake)
+		uint8_t val = 1;
+#endif
+		while( (write(wakeFds[i], &val, sizeof(val)) < 0) && (errno == EINTR) );
+	}
+}
+
+
+void cxa_posix_idle_setSleepSigmask(const sigset_t *const maskIn)
+{
+	cxa_assert(maskIn);
+
+	if( thisThread_wakeFd < 0 ) registerThread();
+
+	thisThread_sleepMask = *maskIn;
+}
+
+
+// ******** local function implementations ********
+static void registerThread(void)
+{
+	// by default, sleep with whatever signals the thread already has blocked
+	pthread_sigmask(SIG_SETMASK, NULL, &thisThread_sleepMask);
+
+	// start 'woken' in case a wakeup was missed while we weren't registered
+#ifdef __linux__
+	int newFd = eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);
+	cxa_assert(newFd >= 0);
+	int newWriteFd = newFd;
+#else
+	int pipeFds[2];
+	cxa_assert(pipe(pipeFds) == 0);
+	for( size_t i = 0; i < 2; i++ )
+	{
+		fcntl(pipeFds[i], F_SETFL, fcntl(pipeFds[i], F_GETFL) | O_NONBLOCK);
+		fcntl(pipeFds[i], F_SETFD, FD_CLOEXEC);
+	}
+	int newFd = pipeFds[0];
+	int newWriteFd = pipeFds[1];
+	uint8_t val = 1;
+	cxa_assert(write(newWriteFd, &val, sizeof(val)) == sizeof(val));
+#endif
+
+	pthread_mutex_lock(&wakeFds_mutex);
+	size_t numFds = atomic_load_explicit(&numWakeFds, memory_order_relaxed);
+	cxa_assert_msg(numFds < CXA_POSIX_IDLE_MAXNUM_THREADS, "increase CXA_POSIX_IDLE_MAXNUM_THREADS");
+	wakeFds[numFds] = newWriteFd;
+	atomic_store_explicit(&numWakeFds, numFds+1, memory_order_release);
+	pthread_mutex_unlock(&wakeFds_mutex);
+
+	thisThread_wakeFd = newFd;
+}
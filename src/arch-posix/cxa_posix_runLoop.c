@@ -0,0 +1,379 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_posix_runLoop.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// the event-driven run loop is built on epoll, so it is only available on Linux
+#ifdef __linux__
+
+
+// ******** includes ********
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+#include <sys/eventfd.h>
+#endif
+
+#include <cxa_array.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define MAX_EVENTS_PER_WAIT				CXA_POSIX_RUNLOOP_MAXNUM_SOURCES
+
+
+// ******** local type definitions ********
+// the epoll set (and sources) for a single run loop
+struct cxa_posix_runLoop_context
+{
+	cxa_runLoop_t* runLoop;
+	int epollFd;
+
+	cxa_array_t sources;
+	cxa_posix_runLoop_source_t* sources_raw[CXA_POSIX_RUNLOOP_MAXNUM_SOURCES];
+
+	// events currently being dispatched (so deinit'd sources can be skipped)
+	struct epoll_event pendingEvents[MAX_EVENTS_PER_WAIT];
+	int numPendingEvents;
+
+	// set once this run loop is iterated by ::cxa_posix_runLoop_instance_iterate
+	bool isServiced;
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	// written whenever work is posted to the run loop
+	int wakeFd;
+	cxa_posix_runLoop_source_t wakeSource;
+#endif
+};
+typedef struct cxa_posix_runLoop_context context_t;
+
+
+// ******** local function prototypes ********
+static context_t* getContext(cxa_runLoop_t *const rlIn);
+static void initContext(context_t *const ctxIn, cxa_runLoop_t *const rlIn);
+static void initSource(cxa_posix_runLoop_source_t *const srcIn, context_t *const ctxIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn);
+static int getWaitTimeout_ms(context_t *const ctxIn);
+static uint32_t toEpollEvents(uint32_t eventsIn);
+static uint32_t fromEpollEvents(uint32_t epollEventsIn);
+static void timerCb_onDeadline(cxa_timer_t *const timerIn, void* userVarIn);
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void runLoopCb_wake(void* userVarIn);
+static void sourceCb_onWake(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn);
+#endif
+
+
+// ********  local variable declarations *********
+// run loops may be bound from different threads
+static pthread_mutex_t contexts_mutex = PTHREAD_MUTEX_INITIALIZER;
+static context_t contexts[CXA_POSIX_RUNLOOP_MAXNUM_RUNLOOPS];
+static size_t numContexts = 0;
+
+
+// ******** global function implementations ********
+void cxa_posix_runLoop_source_init(cxa_posix_runLoop_source_t *const srcIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn)
+{
+	cxa_posix_runLoop_source_init_withRunLoop(srcIn, cxa_runLoop_getDefault(), cbIn, userVarIn);
+}
+
+
+void cxa_posix_runLoop_source_init_withRunLoop(cxa_posix_runLoop_source_t *const srcIn, cxa_runLoop_t *const rlIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn)
+{
+	cxa_assert(srcIn);
+	cxa_assert(rlIn);
+	cxa_assert(cbIn);
+
+	initSource(srcIn, getContext(rlIn), cbIn, userVarIn);
+}
+
+
+void cxa_posix_runLoop_source_deinit(cxa_posix_runLoop_source_t *const srcIn)
+{
+	cxa_assert(srcIn);
+	context_t* ctx = srcIn->context;
+	cxa_assert(ctx);
+
+	cxa_posix_runLoop_source_unwatchFd(srcIn);
+	cxa_posix_runLoop_source_clearDeadline(srcIn);
+
+	// make sure we don't dispatch to this source if it has
+	// pending events in the current iteration
+	for( int i = 0; i < ctx->numPendingEvents; i++ )
+	{
+		if( ctx->pendingEvents[i].data.ptr == srcIn ) ctx->pendingEvents[i].data.ptr = NULL;
+	}
+
+	// can't use cxa_array_iterate because we need an index
+	for( size_t i = 0; i < cxa_array_getSize_elems(&ctx->sources); i++ )
+	{
+		cxa_posix_runLoop_source_t** currEntry = (cxa_posix_runLoop_source_t**)cxa_array_get(&ctx->sources, i);
+		if( (currEntry != NULL) && (*currEntry == srcIn) )
+		{
+			cxa_array_remove_atIndex(&ctx->sources, i);
+			return;
+		}
+	}
+}
+
+
+bool cxa_posix_runLoop_source_watchFd(cxa_posix_runLoop_source_t *const srcIn, int fdIn, uint32_t eventsIn)
+{
+	cxa_assert(srcIn);
+	cxa_assert(srcIn->context);
+	cxa_assert(fdIn >= 0);
+
+	// switching file descriptors?
+	if( (srcIn->fd >= 0) && (srcIn->fd != fdIn) ) cxa_posix_runLoop_source_unwatchFd(srcIn);
+
+	struct epoll_event ev = {.events=toEpollEvents(eventsIn), .data.ptr=srcIn};
+	if( epoll_ctl(srcIn->context->epollFd, (srcIn->fd == fdIn) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fdIn, &ev) != 0 ) return false;
+
+	srcIn->fd = fdIn;
+	srcIn->watchedEvents = eventsIn;
+
+	return true;
+}
+
+
+void cxa_posix_runLoop_source_unwatchFd(cxa_posix_runLoop_source_t *const srcIn)
+{
+	cxa_assert(srcIn);
+	cxa_assert(srcIn->context);
+
+	if( srcIn->fd < 0 ) return;
+
+	// may fail if the fd was already closed (which removes it from the set)
+	epoll_ctl(srcIn->context->epollFd, EPOLL_CTL_DEL, srcIn->fd, NULL);
+	srcIn->fd = -1;
+	srcIn->watchedEvents = 0;
+}
+
+
+void cxa_posix_runLoop_source_setDeadline_ms(cxa_posix_runLoop_source_t *const srcIn, uint32_t deadline_msIn)
+{
+	cxa_assert(srcIn);
+
+	cxa_timer_startOneShot_ms(&srcIn->timer_deadline, deadline_msIn);
+}
+
+
+void cxa_posix_runLoop_source_clearDeadline(cxa_posix_runLoop_source_t *const srcIn)
+{
+	cxa_assert(srcIn);
+
+	cxa_timer_stop(&srcIn->timer_deadline);
+}
+
+
+bool cxa_posix_runLoop_source_isServiced(cxa_posix_runLoop_source_t *const srcIn)
+{
+	cxa_assert(srcIn);
+	cxa_assert(srcIn->context);
+
+	return srcIn->context->isServiced;
+}
+
+
+void cxa_posix_runLoop_iterate(void)
+{
+	cxa_posix_runLoop_instance_iterate(cxa_runLoop_getDefault());
+}
+
+
+void cxa_posix_runLoop_execute(void)
+{
+	cxa_posix_runLoop_instance_execute(cxa_runLoop_getDefault());
+}
+
+
+void cxa_posix_runLoop_instance_iterate(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+	context_t* ctx = getContext(rlIn);
+	ctx->isServiced = true;
+
+	// wait for something to do
+	ctx->numPendingEvents = epoll_wait(ctx->epollFd, ctx->pendingEvents, MAX_EVENTS_PER_WAIT, getWaitTimeout_ms(ctx));
+	if( ctx->numPendingEvents < 0 )
+	{
+		cxa_assert(errno == EINTR);
+		ctx->numPendingEvents = 0;
+	}
+
+	// call our ready sources
+	for( int i = 0; i < ctx->numPendingEvents; i++ )
+	{
+		cxa_posix_runLoop_source_t* currSrc = (cxa_posix_runLoop_source_t*)ctx->pendingEvents[i].data.ptr;
+		if( currSrc == NULL ) continue;
+
+		currSrc->cb(currSrc, fromEpollEvents(ctx->pendingEvents[i].events), currSrc->userVar);
+	}
+	ctx->numPendingEvents = 0;
+
+	// finally, our timers (including source deadlines) and polled entries
+	cxa_runLoop_instance_iterate(rlIn);
+}
+
+
+void cxa_posix_runLoop_instance_execute(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	while(1)
+	{
+		cxa_posix_runLoop_instance_iterate(rlIn);
+	}
+}
+
+
+// ******** local function implementations ********
+static context_t* getContext(cxa_runLoop_t *const rlIn)
+{
+	context_t* retVal = NULL;
+
+	pthread_mutex_lock(&contexts_mutex);
+	for( size_t i = 0; i < numContexts; i++ )
+	{
+		if( contexts[i].runLoop == rlIn )
+		{
+			retVal = &contexts[i];
+			break;
+		}
+	}
+
+	// first time we've seen this run loop
+	if( retVal == NULL )
+	{
+		cxa_assert_msg((numContexts < CXA_POSIX_RUNLOOP_MAXNUM_RUNLOOPS), "increase CXA_POSIX_RUNLOOP_MAXNUM_RUNLOOPS");
+		retVal = &contexts[numContexts++];
+		initContext(retVal, rlIn);
+	}
+	pthread_mutex_unlock(&contexts_mutex);
+
+	return retVal;
+}
+
+
+static void initContext(context_t *const ctxIn, cxa_runLoop_t *const rlIn)
+{
+	ctxIn->runLoop = rlIn;
+	ctxIn->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	cxa_assert(ctxIn->epollFd >= 0);
+
+	cxa_array_initStd(&ctxIn->sources, ctxIn->sources_raw);
+	ctxIn->numPendingEvents = 0;
+	ctxIn->isServiced = false;
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	// wake up whenever work is posted from another thread
+	ctxIn->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	cxa_assert(ctxIn->wakeFd >= 0);
+	initSource(&ctxIn->wakeSource, ctxIn, sourceCb_onWake, (void*)ctxIn);
+	cxa_assert(cxa_posix_runLoop_source_watchFd(&ctxIn->wakeSource, ctxIn->wakeFd, CXA_POSIX_RUNLOOP_EVENT_READABLE));
+	cxa_runLoop_instance_setWakeCb(rlIn, runLoopCb_wake, (void*)ctxIn);
+
+	// in case work was posted before we were initialized
+	runLoopCb_wake((void*)ctxIn);
+#endif
+}
+
+
+static void initSource(cxa_posix_runLoop_source_t *const srcIn, context_t *const ctxIn, cxa_posix_runLoop_cb_onEvent_t cbIn, void* userVarIn)
+{
+	// save our references
+	srcIn->context = ctxIn;
+	srcIn->fd = -1;
+	srcIn->watchedEvents = 0;
+	srcIn->cb = cbIn;
+	srcIn->userVar = userVarIn;
+	cxa_timer_init_withRunLoop(&srcIn->timer_deadline, ctxIn->runLoop, timerCb_onDeadline, (void*)srcIn);
+
+	// register with the run loop
+	cxa_posix_runLoop_source_t* newEntry = srcIn;
+	cxa_assert_msg(cxa_array_append(&ctxIn->sources, &newEntry), "increase CXA_POSIX_RUNLOOP_MAXNUM_SOURCES");
+}
+
+
+static int getWaitTimeout_ms(context_t *const ctxIn)
+{
+	// polled entries (and those with more work) need to be called again immediately
+	if( !cxa_runLoop_instance_canIdle(ctxIn->runLoop) ) return 0;
+
+	// otherwise, sleep until the next timer is due (or forever if there are none)
+	uint32_t timeUntilNextDeadline_ms;
+	if( !cxa_timerWheel_getTimeUntilNextDeadline_ms(cxa_runLoop_instance_getTimerWheel(ctxIn->runLoop), &timeUntilNextDeadline_ms) ) return -1;
+
+	return (timeUntilNextDeadline_ms > INT32_MAX) ? INT32_MAX : (int)timeUntilNextDeadline_ms;
+}
+
+
+static uint32_t toEpollEvents(uint32_t eventsIn)
+{
+	uint32_t retVal = 0;
+	if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_READABLE ) retVal |= EPOLLIN;
+	if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_WRITABLE ) retVal |= EPOLLOUT;
+	return retVal;
+}
+
+
+static uint32_t fromEpollEvents(uint32_t epollEventsIn)
+{
+	uint32_t retVal = 0;
+	if( epollEventsIn & (EPOLLIN | EPOLLPRI) ) retVal |= CXA_POSIX_RUNLOOP_EVENT_READABLE;
+	if( epollEventsIn & EPOLLOUT ) retVal |= CXA_POSIX_RUNLOOP_EVENT_WRITABLE;
+	if( epollEventsIn & (EPOLLERR | EPOLLHUP) ) retVal |= CXA_POSIX_RUNLOOP_EVENT_ERROR;
+	return retVal;
+}
+
+
+static void timerCb_onDeadline(cxa_timer_t *const timerIn, void* userVarIn)
+{
+	cxa_posix_runLoop_source_t* srcIn = (cxa_posix_runLoop_source_t*)userVarIn;
+	cxa_assert(srcIn);
+
+	srcIn->cb(srcIn, CXA_POSIX_RUNLOOP_EVENT_DEADLINE, srcIn->userVar);
+}
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void runLoopCb_wake(void* userVarIn)
+{
+	// async-signal-safe (may be called from any thread / signal handler)
+	context_t* ctx = (context_t*)userVarIn;
+	uint64_t val = 1;
+	while( (write(ctx->wakeFd, &val, sizeof(val)) < 0) && (errno == EINTR) );
+}
+
+
+static void sourceCb_onWake(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn)
+{
+	// reset the eventfd...posted work is called during cxa_runLoop_iterate
+	context_t* ctx = (context_t*)userVarIn;
+	uint64_t val;
+	while( (read(ctx->wakeFd, &val, sizeof(val)) < 0) && (errno == EINTR) );
+}
+#endif
+
+
+#endif // __linux__
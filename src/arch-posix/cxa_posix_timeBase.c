@@ -13,14 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <cxa_assert.h>
 #include <cxa_posix_timeBase.h>
+
+
+// ******** includes ********
 #include <time.h>
-#include <sys/time.h>
+#include <cxa_assert.h>
 
 #ifdef __MACH__
-#include <mach/clock.h>
-#include <mach/mach.h>
+#include <mach/mach_time.h>
 #endif
 
 
@@ -31,51 +32,48 @@
 
 
 // ******** local function prototypes ********
-static void current_utc_time(struct timeval *ts);
 
 
 // ********  local variable declarations *********
+#ifdef __MACH__
+static mach_timebase_info_data_t machTimebaseInfo;
+#endif
 
 
 // ******** global function implementations ********
-void cxa_posix_timeBase_init(cxa_timeBase_t *const tbIn)
+void cxa_posix_timeBase_init(void)
 {
-	cxa_assert(tbIn);
-	// nothing to do here
+	#ifdef __MACH__
+		cxa_assert(mach_timebase_info(&machTimebaseInfo) == KERN_SUCCESS);
+	#endif
 }
 
 
-uint32_t cxa_timeBase_getCount_us(cxa_timeBase_t *const superIn)
+uint32_t cxa_timeBase_getCount_us(void)
 {
-	cxa_assert(superIn);
-	
-	struct timeval ts;
-	current_utc_time(&ts);
-	return (1000000 * ts.tv_sec) + (ts.tv_usec);
+	// truncation means we overflow cleanly at UINT32_MAX
+	return (uint32_t)(cxa_timeBase_getCount64_ns() / 1000);
 }
 
 
-uint32_t cxa_timeBase_getMaxCount_us(cxa_timeBase_t *const superIn)
+uint32_t cxa_timeBase_getMaxCount_us(void)
 {
-	cxa_assert(superIn);
-	
 	return UINT32_MAX;
 }
 
 
-// ******** local function implementations ********
-static void current_utc_time(struct timeval *ts)
+uint64_t cxa_timeBase_getCount64_ns(void)
 {
-	#ifdef __MACH__ // OS X does not have clock_gettime, use clock_get_time
-		clock_serv_t cclock;
-		mach_timespec_t mts;
-		host_get_clock_service(mach_host_self(), CALENDAR_CLOCK, &cclock);
-		clock_get_time(cclock, &mts);
-		mach_port_deallocate(mach_task_self(), cclock);
-		ts->tv_sec = mts.tv_sec;
-		ts->tv_usec = mts.tv_nsec / 1000;
+	#ifdef __MACH__
+		// OS X (prior to 10.12) does not have clock_gettime
+		if( machTimebaseInfo.denom == 0 ) cxa_posix_timeBase_init();
+		return mach_absolute_time() * machTimebaseInfo.numer / machTimebaseInfo.denom;
 	#else
-		gettimeofday(ts, NULL);
+		struct timespec ts;
+		cxa_assert(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+		return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
 	#endif
 }
 
+
+// ******** local function implementations ********
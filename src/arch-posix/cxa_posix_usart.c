@@ -25,10 +25,14 @@
 #include <stdbool.h>
 #include <cxa_assert.h>
 
+#include <cxa_runLoop.h>
+
 #include <errno.h>
+#include <poll.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/uio.h>
 
 
 // ******** local macro definitions ********
@@ -41,8 +45,20 @@
 static bool set_interface_attribs (int fd, int speed, int parity);
 static bool set_blocking (int fd, int should_block);
 
+static void cb_onRunLoopUpdate(void* userVarIn);
+#ifdef __linux__
+static void sourceCb_onEvent(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn);
+#endif
+static void service(cxa_posix_usart_t *const usartIn);
+static void updateWatchedEvents(cxa_posix_usart_t *const usartIn);
+static void fillRxFifo(cxa_posix_usart_t *const usartIn);
+static void flushTxFifo(cxa_posix_usart_t *const usartIn);
+static bool waitForWritable(cxa_posix_usart_t *const usartIn);
+
 static cxa_ioStream_readStatus_t ioStream_cb_readByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t ioStream_cb_readBytes(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool ioStream_cb_writeVector(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn);
 
 
 // ********  local variable declarations *********
@@ -50,19 +66,53 @@ static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 
 // ******** global function implementations ********
 bool cxa_posix_usart_init_noHH(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn)
+{
+	return cxa_posix_usart_init_noHH_withRunLoop(usartIn, pathIn, baudRateIn, cxa_runLoop_getDefault());
+}
+
+
+bool cxa_posix_usart_init_noHH_withRunLoop(cxa_posix_usart_t *const usartIn, char *const pathIn, const int baudRateIn, cxa_runLoop_t *const rlIn)
 {
 	cxa_assert(usartIn);
 	cxa_assert(pathIn);
+	cxa_assert(rlIn);
 
-	usartIn->fd = open(pathIn, O_RDWR | O_NOCTTY | O_SYNC);
+	usartIn->fd = open(pathIn, O_RDWR | O_NOCTTY | O_NONBLOCK);
 	if( usartIn->fd < 0 ) return false;
 
-	if( !set_interface_attribs (usartIn->fd, baudRateIn, 0) ) return false;
-	if( !set_blocking (usartIn->fd, 0) ) return false;
+	if( !set_interface_attribs (usartIn->fd, baudRateIn, 0) || !set_blocking (usartIn->fd, 0) )
+	{
+		close(usartIn->fd);
+		usartIn->fd = -1;
+		return false;
+	}
+
+	// setup our buffers
+	usartIn->hasError = false;
+	usartIn->runLoop = rlIn;
+	cxa_fixedFifo_initStd(&usartIn->rxFifo, CXA_FF_ON_FULL_DROP, usartIn->rxFifo_raw);
+	cxa_fixedFifo_initStd(&usartIn->txFifo, CXA_FF_ON_FULL_DROP, usartIn->txFifo_raw);
 
 	// setup our ioStream (last once everything is setup)
 	cxa_ioStream_init(&usartIn->super.ioStream);
 	cxa_ioStream_bind(&usartIn->super.ioStream, ioStream_cb_readByte, ioStream_cb_writeBytes, (void*)usartIn);
+	cxa_ioStream_bind_readBytes(&usartIn->super.ioStream, ioStream_cb_readBytes);
+	cxa_ioStream_bind_writeVector(&usartIn->super.ioStream, ioStream_cb_writeVector);
+
+#ifdef __linux__
+	// called by the event-driven run loop when the port is ready
+	cxa_posix_runLoop_source_init_withRunLoop(&usartIn->source, usartIn->runLoop, sourceCb_onEvent, (void*)usartIn);
+	if( !cxa_posix_runLoop_source_watchFd(&usartIn->source, usartIn->fd, CXA_POSIX_RUNLOOP_EVENT_READABLE) )
+	{
+		cxa_posix_runLoop_source_deinit(&usartIn->source);
+		close(usartIn->fd);
+		usartIn->fd = -1;
+		return false;
+	}
+#endif
+
+	// polled until the event-driven run loop takes over (if ever)
+	cxa_runLoop_instance_addEntry(usartIn->runLoop, cb_onRunLoopUpdate, (void*)usartIn);
 
 	return true;
 }
@@ -72,7 +122,19 @@ void cxa_posix_usart_close(cxa_posix_usart_t *const usartIn)
 {
 	cxa_assert(usartIn);
 
+	if( usartIn->fd < 0 ) return;
+
+	// we no longer need servicing
+	cxa_runLoop_instance_removeEntry_withUserVar(usartIn->runLoop, cb_onRunLoopUpdate, (void*)usartIn);
+#ifdef __linux__
+	cxa_posix_runLoop_source_deinit(&usartIn->source);
+#endif
+
+	// try to get out whatever we have queued
+	flushTxFifo(usartIn);
+
 	close(usartIn->fd);
+	usartIn->fd = -1;
 }
 
 
@@ -92,7 +154,7 @@ static bool set_interface_attribs (int fd, int speed, int parity)
 {
 	struct termios tty;
 	memset (&tty, 0, sizeof tty);
-	if (tcgetattr (fd, &tty) != 0) return -1;
+	if (tcgetattr (fd, &tty) != 0) return false;
 
 	cfsetospeed (&tty, speed);
 	cfsetispeed (&tty, speed);
@@ -105,7 +167,7 @@ static bool set_interface_attribs (int fd, int speed, int parity)
 	// no canonical processing
 	tty.c_oflag = 0;                // no remapping, no delays
 	tty.c_cc[VMIN]  = 0;            // read doesn't block
-	tty.c_cc[VTIME] = 5;            // 0.5 seconds read timeout
+	tty.c_cc[VTIME] = 0;            // no read timeout (we poll for readiness)
 
 	tty.c_iflag &= ~(IXON | IXOFF | IXANY); // shut off xon/xoff ctrl
 
@@ -116,7 +178,7 @@ static bool set_interface_attribs (int fd, int speed, int parity)
 	tty.c_cflag &= ~CSTOPB;
 	tty.c_cflag &= ~CRTSCTS;
 
-	if (tcsetattr (fd, TCSANOW, &tty) != 0) false;
+	if (tcsetattr (fd, TCSANOW, &tty) != 0) return false;
 	return true;
 }
 
@@ -128,44 +190,280 @@ static bool set_blocking (int fd, int should_block)
 	if (tcgetattr (fd, &tty) != 0) return false;
 
 	tty.c_cc[VMIN]  = should_block ? 1 : 0;
-	tty.c_cc[VTIME] = 5;            // 0.5 seconds read timeout
+	tty.c_cc[VTIME] = 0;            // no read timeout (we poll for readiness)
 
 	if (tcsetattr (fd, TCSANOW, &tty) != 0) return false;
 
+	// make sure the descriptor itself matches
+	int flags = fcntl(fd, F_GETFL, 0);
+	if( flags < 0 ) return false;
+	flags = should_block ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+	if( fcntl(fd, F_SETFL, flags) != 0 ) return false;
+
 	return true;
 }
 
 
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+#ifdef __linux__
+	// the event-driven run loop services us when we're ready...no need to poll
+	if( cxa_posix_runLoop_source_isServiced(&usartIn->source) )
+	{
+		cxa_runLoop_instance_removeEntry_withUserVar(usartIn->runLoop, cb_onRunLoopUpdate, (void*)usartIn);
+
+		// only now will we signal when data arrives (so readers may stop polling)
+		cxa_ioStream_bind_signalsReadable(&usartIn->super.ioStream, true);
+		return;
+	}
+#endif
+
+	service(usartIn);
+}
+
+
+#ifdef __linux__
+static void sourceCb_onEvent(cxa_posix_runLoop_source_t *const srcIn, uint32_t eventsIn, void* userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+
+	if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_ERROR )
+	{
+		// our reader needs to see the error
+		usartIn->hasError = true;
+		cxa_runLoop_instance_signalMoreWork(usartIn->runLoop);
+	}
+	if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_READABLE )
+	{
+		size_t prevNumRxBytes = cxa_fixedFifo_getSize_elems(&usartIn->rxFifo);
+		fillRxFifo(usartIn);
+
+		// let our reader know there is data waiting
+		if( cxa_fixedFifo_getSize_elems(&usartIn->rxFifo) != prevNumRxBytes ) cxa_runLoop_instance_signalMoreWork(usartIn->runLoop);
+	}
+	if( eventsIn & CXA_POSIX_RUNLOOP_EVENT_WRITABLE ) flushTxFifo(usartIn);
+
+	updateWatchedEvents(usartIn);
+}
+#endif
+
+
+static void service(cxa_posix_usart_t *const usartIn)
+{
+	cxa_assert(usartIn);
+
+	if( (usartIn->fd < 0) || usartIn->hasError ) return;
+
+	// see what the port is ready for (without blocking)
+	struct pollfd pfd = {.fd=usartIn->fd, .events=POLLIN, .revents=0};
+	if( !cxa_fixedFifo_isEmpty(&usartIn->txFifo) ) pfd.events |= POLLOUT;
+	int retVal_poll = poll(&pfd, 1, 0);
+	if( retVal_poll < 0 )
+	{
+		if( errno != EINTR ) usartIn->hasError = true;
+		return;
+	}
+	else if( retVal_poll == 0 ) return;
+
+	if( pfd.revents & (POLLERR | POLLNVAL) ) usartIn->hasError = true;
+	else
+	{
+		if( pfd.revents & (POLLIN | POLLHUP) ) fillRxFifo(usartIn);
+		if( pfd.revents & POLLOUT ) flushTxFifo(usartIn);
+	}
+
+	updateWatchedEvents(usartIn);
+}
+
+
+static void updateWatchedEvents(cxa_posix_usart_t *const usartIn)
+{
+	cxa_assert(usartIn);
+
+#ifdef __linux__
+	if( usartIn->fd < 0 ) return;
+
+	// stop watching a broken port (would otherwise be reported every iteration)
+	if( usartIn->hasError )
+	{
+		cxa_posix_runLoop_source_unwatchFd(&usartIn->source);
+		return;
+	}
+
+	// readable only while we have room, writable only while we have data to send
+	uint32_t events = 0;
+	if( !cxa_fixedFifo_isFull(&usartIn->rxFifo) ) events |= CXA_POSIX_RUNLOOP_EVENT_READABLE;
+	if( !cxa_fixedFifo_isEmpty(&usartIn->txFifo) ) events |= CXA_POSIX_RUNLOOP_EVENT_WRITABLE;
+
+	if( (usartIn->source.fd != usartIn->fd) || (usartIn->source.watchedEvents != events) )
+	{
+		if( !cxa_posix_runLoop_source_watchFd(&usartIn->source, usartIn->fd, events) ) usartIn->hasError = true;
+	}
+#endif
+}
+
+
+static void fillRxFifo(cxa_posix_usart_t *const usartIn)
+{
+	cxa_assert(usartIn);
+
+	while( !cxa_fixedFifo_isFull(&usartIn->rxFifo) )
+	{
+		// read straight into the fifo's free space
+		void* rxBytes;
+		size_t numBytesToRead = cxa_fixedFifo_bulkQueue_reserve(&usartIn->rxFifo, &rxBytes);
+
+		ssize_t retVal_read = read(usartIn->fd, rxBytes, numBytesToRead);
+		if( retVal_read < 0 )
+		{
+			if( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) ) usartIn->hasError = true;
+			return;
+		}
+		else if( retVal_read == 0 ) return;
+
+		cxa_fixedFifo_bulkQueue_commit(&usartIn->rxFifo, (size_t)retVal_read);
+
+		// a short read means the port is drained
+		if( (size_t)retVal_read < numBytesToRead ) return;
+	}
+}
+
+
+static void flushTxFifo(cxa_posix_usart_t *const usartIn)
+{
+	cxa_assert(usartIn);
+
+	while( !cxa_fixedFifo_isEmpty(&usartIn->txFifo) && (usartIn->fd >= 0) )
+	{
+		// write both contiguous runs with a single call
+		cxa_fixedFifo_segment_t seg1, seg2;
+		size_t numBytesPending = cxa_fixedFifo_bulkDequeue_peekSegments(&usartIn->txFifo, &seg1, &seg2);
+		struct iovec iov[2] = { {.iov_base=seg1.elems, .iov_len=seg1.numElems}, {.iov_base=seg2.elems, .iov_len=seg2.numElems} };
+
+		ssize_t retVal_write = writev(usartIn->fd, iov, (seg2.numElems > 0) ? 2 : 1);
+		if( retVal_write < 0 )
+		{
+			if( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) ) usartIn->hasError = true;
+			return;
+		}
+
+		cxa_fixedFifo_bulkDequeue(&usartIn->txFifo, (size_t)retVal_write);
+
+		// a short write means the port can't take any more right now
+		if( (size_t)retVal_write < numBytesPending ) return;
+	}
+}
+
+
+static bool waitForWritable(cxa_posix_usart_t *const usartIn)
+{
+	cxa_assert(usartIn);
+
+	struct pollfd pfd = {.fd=usartIn->fd, .events=POLLOUT, .revents=0};
+	int retVal_poll;
+	while( ((retVal_poll = poll(&pfd, 1, CXA_POSIX_USART_TX_TIMEOUT_MS)) < 0) && (errno == EINTR) );
+
+	if( (retVal_poll < 0) || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) ) usartIn->hasError = true;
+	return (retVal_poll > 0) && !usartIn->hasError;
+}
+
+
 static cxa_ioStream_readStatus_t ioStream_cb_readByte(uint8_t *const byteOut, void *const userVarIn)
 {
 	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
 	cxa_assert(usartIn);
 
-	// perform our read and check the return value
-	ssize_t retVal_read = read(usartIn->fd, byteOut, 1);
-	if( retVal_read < 0 ) return CXA_IOSTREAM_READSTAT_ERROR;
-	else if( retVal_read == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+	// only go to the port if we've run dry
+	if( cxa_fixedFifo_isEmpty(&usartIn->rxFifo) ) service(usartIn);
+
+	if( cxa_fixedFifo_dequeue(&usartIn->rxFifo, byteOut) )
+	{
+		// may have made room to receive again
+		updateWatchedEvents(usartIn);
+		return CXA_IOSTREAM_READSTAT_GOTDATA;
+	}
+	return usartIn->hasError ? CXA_IOSTREAM_READSTAT_ERROR : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+static cxa_ioStream_readStatus_t ioStream_cb_readBytes(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
+	cxa_assert(usartIn);
+	cxa_assert(numBytesReadOut);
+
+	// only go to the port if we've run dry
+	if( cxa_fixedFifo_isEmpty(&usartIn->rxFifo) ) service(usartIn);
+
+	size_t numBytesRead = cxa_fixedFifo_bulkDequeue_copy(&usartIn->rxFifo, buffOut, maxLen_bytesIn);
 
-	return CXA_IOSTREAM_READSTAT_GOTDATA;
+	// may have made room to receive again
+	if( numBytesRead > 0 ) updateWatchedEvents(usartIn);
+
+	*numBytesReadOut = numBytesRead;
+	if( numBytesRead > 0 ) return CXA_IOSTREAM_READSTAT_GOTDATA;
+	return usartIn->hasError ? CXA_IOSTREAM_READSTAT_ERROR : CXA_IOSTREAM_READSTAT_NODATA;
 }
 
 
 static bool ioStream_cb_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
+{
+	cxa_ioStream_vector_t vector = {.buff=buffIn, .size_bytes=bufferSize_bytesIn};
+	return ioStream_cb_writeVector(&vector, 1, userVarIn);
+}
+
+
+static bool ioStream_cb_writeVector(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn)
 {
 	cxa_posix_usart_t* usartIn = (cxa_posix_usart_t*)userVarIn;
 	cxa_assert(usartIn);
 
-	size_t numBytesRemaining = bufferSize_bytesIn;
-	size_t numBytesSent = 0;
-	while( numBytesRemaining != 0 )
+	if( usartIn->hasError || (usartIn->fd < 0) ) return false;
+
+	// a write that fits in our buffer is queued all at once (so a refused write queued nothing)
+	size_t numBytesTotal = 0;
+	for( size_t i = 0; i < numVectorsIn; i++ ) numBytesTotal += vectorsIn[i].size_bytes;
+	size_t txFifoSize_bytes = cxa_fixedFifo_getSize_elems(&usartIn->txFifo) + cxa_fixedFifo_getFreeSize_elems(&usartIn->txFifo);
+	size_t numBytesNeeded = (numBytesTotal < txFifoSize_bytes) ? numBytesTotal : txFifoSize_bytes;
+	while( cxa_fixedFifo_getFreeSize_elems(&usartIn->txFifo) < numBytesNeeded )
 	{
-		ssize_t retVal_write = write(usartIn->fd, (void*)&(((uint8_t*)buffIn)[numBytesSent]), numBytesRemaining);
-		if( retVal_write < 0 ) return false;
+		flushTxFifo(usartIn);
+		if( (cxa_fixedFifo_getFreeSize_elems(&usartIn->txFifo) < numBytesNeeded) && !waitForWritable(usartIn) ) return false;
+	}
 
-		// if we made it here, retVal_write is positive
-		numBytesSent += (size_t)retVal_write;
-		numBytesRemaining -= (size_t)retVal_write;
+	// queue our data (flushed when the port is writable)
+	for( size_t i = 0; i < numVectorsIn; i++ )
+	{
+		uint8_t* currBytes = (uint8_t*)vectorsIn[i].buff;
+		size_t numBytesRemaining = vectorsIn[i].size_bytes;
+		while( numBytesRemaining > 0 )
+		{
+			size_t numBytesToQueue = cxa_fixedFifo_getFreeSize_elems(&usartIn->txFifo);
+			if( numBytesToQueue > numBytesRemaining ) numBytesToQueue = numBytesRemaining;
+			if( (numBytesToQueue > 0) && !cxa_fixedFifo_bulkQueue(&usartIn->txFifo, currBytes, numBytesToQueue) ) return false;
+			currBytes += numBytesToQueue;
+			numBytesRemaining -= numBytesToQueue;
+			if( numBytesRemaining == 0 ) break;
+
+			// larger than our buffer...make room (waiting for the port to drain if needed)
+			flushTxFifo(usartIn);
+			if( cxa_fixedFifo_isFull(&usartIn->txFifo) && !waitForWritable(usartIn) )
+			{
+				// part of this write already went out...it can't be retried cleanly
+				usartIn->hasError = true;
+				return false;
+			}
+		}
 	}
 
-	return true;
+	// try to get it all out now (single writev)...the rest
+	// goes out once the port is writable
+	flushTxFifo(usartIn);
+	updateWatchedEvents(usartIn);
+
+	return !usartIn->hasError;
 }
@@ -104,6 +104,20 @@ void* cxa_array_append_empty(cxa_array_t *const arrIn)
 }
 
 
+void* cxa_array_append_emptyElems(cxa_array_t *const arrIn, const size_t numElemsIn)
+{
+	cxa_assert(arrIn);
+
+	// make sure we have enough space in the array
+	if( numElemsIn > (arrIn->maxNumElements - arrIn->insertIndex) ) return NULL;
+
+	void *retVal = (void*)(((uint8_t*)arrIn->bufferLoc) + (arrIn->insertIndex * arrIn->datatypeSize_bytes));
+	arrIn->insertIndex += numElemsIn;
+
+	return retVal;
+}
+
+
 bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn)
 {
 	cxa_assert(arrIn);
@@ -120,7 +134,7 @@ bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn)
 
 	// if we made it here, we have some data to move around
 	void *dest = (void*)(((uint8_t*)arrIn->bufferLoc) + (indexIn * arrIn->datatypeSize_bytes));
-	void *src = (void*)(((uint8_t*)arrIn->bufferLoc) + (indexIn+1 * arrIn->datatypeSize_bytes));
+	void *src = (void*)(((uint8_t*)arrIn->bufferLoc) + ((indexIn+1) * arrIn->datatypeSize_bytes));
 
 	memmove(dest, src, ((arrIn->insertIndex-(indexIn+1)) * arrIn->datatypeSize_bytes));
 	arrIn->insertIndex--;
@@ -129,6 +143,27 @@ bool cxa_array_remove_atIndex(cxa_array_t *const arrIn, const size_t indexIn)
 }
 
 
+bool cxa_array_remove_atIndex_numElems(cxa_array_t *const arrIn, const size_t indexIn, const size_t numElemsIn)
+{
+	cxa_assert(arrIn);
+
+	// make sure we're not out of bounds
+	if( (indexIn > arrIn->insertIndex) || (numElemsIn > (arrIn->insertIndex - indexIn)) ) return false;
+
+	// move any following elements down (nothing to move if we're removing from the end)
+	size_t numElemsToMove = arrIn->insertIndex - (indexIn + numElemsIn);
+	if( numElemsToMove > 0 )
+	{
+		void *dest = (void*)(((uint8_t*)arrIn->bufferLoc) + (indexIn * arrIn->datatypeSize_bytes));
+		void *src = (void*)(((uint8_t*)arrIn->bufferLoc) + ((indexIn + numElemsIn) * arrIn->datatypeSize_bytes));
+		memmove(dest, src, (numElemsToMove * arrIn->datatypeSize_bytes));
+	}
+	arrIn->insertIndex -= numElemsIn;
+
+	return true;
+}
+
+
 bool cxa_array_remove(cxa_array_t *const arrIn, void *const itemLocIn)
 {
 	cxa_assert(arrIn);
@@ -104,11 +104,12 @@ bool cxa_fixedByteBuffer_append(cxa_fixedByteBuffer_t *const fbbIn, uint8_t *con
 
 	// make sure we have room for the operation
 	if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return false;
+	if( numBytesIn == 0 ) return true;
 
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		if( !cxa_array_append(&fbbIn->bytes, &(ptrIn[i])) ) return false;
-	}
+	// reserve our space, then copy in one go
+	uint8_t* dest = (uint8_t*)cxa_fixedByteBuffer_append_emptyBytes(fbbIn, numBytesIn);
+	if( dest == NULL ) return false;
+	memcpy(dest, ptrIn, numBytesIn);
 
 	return true;
 }
@@ -133,16 +134,8 @@ void* cxa_fixedByteBuffer_append_emptyBytes(cxa_fixedByteBuffer_t *const fbbIn,
 {
 	cxa_assert(fbbIn);
 
-	// make sure we have room for the operation
-	if( cxa_fixedByteBuffer_getFreeSize_bytes(fbbIn) < numBytesIn ) return NULL;
-
-	void* retVal = cxa_fixedByteBuffer_get_pointerToIndex(fbbIn, cxa_fixedByteBuffer_getSize_bytes(fbbIn));
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		// shouldn't happen, but we should test
-		if( !cxa_array_append_empty(&fbbIn->bytes) ) return NULL;
-	}
-	return retVal;
+	// returns NULL if we don't have room for the operation
+	return cxa_array_append_emptyElems(&fbbIn->bytes, numBytesIn);
 }
 
 
@@ -153,12 +146,7 @@ bool cxa_fixedByteBuffer_remove(cxa_fixedByteBuffer_t *const fbbIn, const size_t
 	// make sure we have room for the operation
 	if( (indexIn + numBytesIn) > cxa_fixedByteBuffer_getSize_bytes(fbbIn) ) return false;
 
-	for( size_t i = 0; i < numBytesIn; i++ )
-	{
-		if( !cxa_array_remove_atIndex(&fbbIn->bytes, indexIn) ) return false;
-	}
-
-	return true;
+	return cxa_array_remove_atIndex_numElems(&fbbIn->bytes, indexIn, numBytesIn);
 }
 
 
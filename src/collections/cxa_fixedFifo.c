@@ -155,15 +155,92 @@ bool cxa_fixedFifo_dequeue(cxa_fixedFifo_t *const fifoIn, void *elemOut)
 bool cxa_fixedFifo_bulkQueue(cxa_fixedFifo_t *const fifoIn, void *const elemsIn, size_t numElemsIn)
 {
 	cxa_assert(fifoIn);
+	if( numElemsIn == 0 ) return true;
 	cxa_assert(elemsIn);
 
-	// simplistic implementation...we can probably make this more efficient
-	for( size_t i = 0; i < numElemsIn; i++ )
+	uint8_t* srcElems = (uint8_t*)elemsIn;
+	bool retVal = true;
+
+	// if we don't have room, figure out what we should do
+	size_t freeSize_elems = cxa_fixedFifo_getFreeSize_elems(fifoIn);
+	if( numElemsIn > freeSize_elems )
 	{
-		if( !cxa_fixedFifo_queue(fifoIn, &(((uint8_t*)elemsIn)[i*fifoIn->datatypeSize_bytes])) ) return false;
+		switch( fifoIn->onFullAction )
+		{
+			case CXA_FF_ON_FULL_DEQUEUE:
+			{
+				// only the most recent elements can possibly fit
+				size_t maxNumElems = fifoIn->maxNumElements - 1;
+				if( numElemsIn > maxNumElems )
+				{
+					srcElems += (numElemsIn - maxNumElems) * fifoIn->datatypeSize_bytes;
+					numElemsIn = maxNumElems;
+				}
+
+				// make room by discarding the oldest elements
+				cxa_fixedFifo_bulkDequeue(fifoIn, numElemsIn - cxa_fixedFifo_getFreeSize_elems(fifoIn));
+				break;
+			}
+
+			case CXA_FF_ON_FULL_DROP:
+				// queue what we can
+				numElemsIn = freeSize_elems;
+				retVal = false;
+				break;
+		}
 	}
 
-	return true;
+	// copy in (at most two runs, split where the buffer wraps)
+	size_t numElems_untilWrap = fifoIn->maxNumElements - fifoIn->insertIndex;
+	size_t numElems_firstRun = (numElemsIn < numElems_untilWrap) ? numElemsIn : numElems_untilWrap;
+	memcpy((void*)(((uint8_t*)fifoIn->bufferLoc) + (fifoIn->insertIndex * fifoIn->datatypeSize_bytes)), srcElems, numElems_firstRun * fifoIn->datatypeSize_bytes);
+	if( numElemsIn > numElems_firstRun )
+	{
+		memcpy(fifoIn->bufferLoc, srcElems + (numElems_firstRun * fifoIn->datatypeSize_bytes), (numElemsIn - numElems_firstRun) * fifoIn->datatypeSize_bytes);
+	}
+
+	// only publish the new elements once they've been copied
+	size_t newInsertIndex = fifoIn->insertIndex + numElemsIn;
+	fifoIn->insertIndex = (newInsertIndex >= fifoIn->maxNumElements) ? (newInsertIndex - fifoIn->maxNumElements) : newInsertIndex;
+
+	return retVal;
+}
+
+
+size_t cxa_fixedFifo_bulkQueue_reserve(cxa_fixedFifo_t *const fifoIn, void **const elemsOut)
+{
+	cxa_assert(fifoIn);
+
+	size_t lcl_insertIndex = fifoIn->insertIndex;
+	size_t lcl_removeIndex = fifoIn->removeIndex;
+
+	if( elemsOut != NULL ) *elemsOut = &(((uint8_t*)fifoIn->bufferLoc)[lcl_insertIndex*fifoIn->datatypeSize_bytes]);
+
+	// one slot is always left empty (immediately before the remove index)
+	if( lcl_insertIndex >= lcl_removeIndex )
+	{
+		return (fifoIn->maxNumElements - lcl_insertIndex) - ((lcl_removeIndex == 0) ? 1 : 0);
+	}
+	return lcl_removeIndex - lcl_insertIndex - 1;
+}
+
+
+bool cxa_fixedFifo_bulkQueue_commit(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	bool retVal = true;
+	size_t numElems_reserved = cxa_fixedFifo_bulkQueue_reserve(fifoIn, NULL);
+	if( numElemsIn > numElems_reserved )
+	{
+		numElemsIn = numElems_reserved;
+		retVal = false;
+	}
+
+	size_t newInsertIndex = fifoIn->insertIndex + numElemsIn;
+	fifoIn->insertIndex = (newInsertIndex >= fifoIn->maxNumElements) ? (newInsertIndex - fifoIn->maxNumElements) : newInsertIndex;
+
+	return retVal;
 }
 
 
@@ -171,13 +248,36 @@ bool cxa_fixedFifo_bulkDequeue(cxa_fixedFifo_t *const fifoIn, size_t numElemsIn)
 {
 	cxa_assert(fifoIn);
 
-	// simplistic implementation...we can probably make this more efficient
-	for( size_t i = 0; i < numElemsIn; i++ )
+	#if CXA_FF_MAX_LISTENERS > 0
+		bool wasFull = cxa_fixedFifo_isFull(fifoIn);
+	#endif
+
+	bool retVal = true;
+	size_t currSize_elems = cxa_fixedFifo_getSize_elems(fifoIn);
+	if( numElemsIn > currSize_elems )
 	{
-		if( !cxa_fixedFifo_dequeue(fifoIn, NULL) ) return false;
+		numElemsIn = currSize_elems;
+		retVal = false;
 	}
+	if( numElemsIn == 0 ) return retVal;
 
-	return true;
+	size_t newRemoveIndex = fifoIn->removeIndex + numElemsIn;
+	fifoIn->removeIndex = (newRemoveIndex >= fifoIn->maxNumElements) ? (newRemoveIndex - fifoIn->maxNumElements) : newRemoveIndex;
+
+	#if CXA_FF_MAX_LISTENERS > 0
+		// notify our listeners
+		if( wasFull )
+		{
+			cxa_array_iterate(&fifoIn->listeners, currEntry, cxa_fixedFifo_listener_entry_t)
+			{
+				if( currEntry == NULL ) continue;
+
+				if( currEntry->cb_noLongerFull != NULL ) currEntry->cb_noLongerFull(fifoIn, currEntry->userVarIn);
+			}
+		}
+	#endif
+
+	return retVal;
 }
 
 
@@ -193,6 +293,54 @@ size_t cxa_fixedFifo_bulkDequeue_peek(cxa_fixedFifo_t *const fifoIn, void **cons
 }
 
 
+size_t cxa_fixedFifo_bulkDequeue_peekSegments(cxa_fixedFifo_t *const fifoIn, cxa_fixedFifo_segment_t *const seg1Out, cxa_fixedFifo_segment_t *const seg2Out)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(seg1Out);
+	cxa_assert(seg2Out);
+
+	size_t lcl_insertIndex = fifoIn->insertIndex;
+	size_t lcl_removeIndex = fifoIn->removeIndex;
+
+	seg1Out->elems = &(((uint8_t*)fifoIn->bufferLoc)[lcl_removeIndex*fifoIn->datatypeSize_bytes]);
+	seg2Out->elems = fifoIn->bufferLoc;
+	if( lcl_insertIndex >= lcl_removeIndex )
+	{
+		seg1Out->numElems = lcl_insertIndex - lcl_removeIndex;
+		seg2Out->numElems = 0;
+	}
+	else
+	{
+		seg1Out->numElems = fifoIn->maxNumElements - lcl_removeIndex;
+		seg2Out->numElems = lcl_insertIndex;
+	}
+
+	return seg1Out->numElems + seg2Out->numElems;
+}
+
+
+size_t cxa_fixedFifo_bulkDequeue_copy(cxa_fixedFifo_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	cxa_fixedFifo_segment_t seg1, seg2;
+	cxa_fixedFifo_bulkDequeue_peekSegments(fifoIn, &seg1, &seg2);
+
+	size_t numElems_seg1 = (maxNumElemsIn < seg1.numElems) ? maxNumElemsIn : seg1.numElems;
+	size_t numElems_seg2 = ((maxNumElemsIn - numElems_seg1) < seg2.numElems) ? (maxNumElemsIn - numElems_seg1) : seg2.numElems;
+	if( (numElems_seg1 + numElems_seg2) == 0 ) return 0;
+
+	if( elemsOut != NULL )
+	{
+		memcpy(elemsOut, seg1.elems, numElems_seg1 * fifoIn->datatypeSize_bytes);
+		if( numElems_seg2 > 0 ) memcpy(((uint8_t*)elemsOut) + (numElems_seg1 * fifoIn->datatypeSize_bytes), seg2.elems, numElems_seg2 * fifoIn->datatypeSize_bytes);
+	}
+	cxa_fixedFifo_bulkDequeue(fifoIn, numElems_seg1 + numElems_seg2);
+
+	return numElems_seg1 + numElems_seg2;
+}
+
+
 size_t cxa_fixedFifo_getSize_elems(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
@@ -207,7 +355,8 @@ size_t cxa_fixedFifo_getFreeSize_elems(cxa_fixedFifo_t *const fifoIn)
 {
 	cxa_assert(fifoIn);
 
-	return fifoIn->maxNumElements - cxa_fixedFifo_getSize_elems(fifoIn);
+	// one slot is always left empty to distinguish full from empty
+	return (fifoIn->maxNumElements - 1) - cxa_fixedFifo_getSize_elems(fifoIn);
 }
 
 
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_fixedFifo_spsc.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <string.h>
+#include <stdint.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static inline size_t advanceIndex(cxa_fixedFifo_spsc_t *const fifoIn, size_t indexIn, size_t numElemsIn);
+static inline size_t getNumElems(cxa_fixedFifo_spsc_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn);
+static inline uint8_t* getElemPtr(cxa_fixedFifo_spsc_t *const fifoIn, size_t indexIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_fixedFifo_spsc_init(cxa_fixedFifo_spsc_t *const fifoIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(datatypeSize_bytesIn > 0);
+	cxa_assert(datatypeSize_bytesIn <= bufferMaxSize_bytesIn);
+	cxa_assert(bufferLocIn);
+
+	// save our references
+	fifoIn->datatypeSize_bytes = datatypeSize_bytesIn;
+	fifoIn->bufferLoc = bufferLocIn;
+	fifoIn->maxNumElements = bufferMaxSize_bytesIn / datatypeSize_bytesIn;
+
+	// set some reasonable defaults
+	atomic_init(&fifoIn->insertIndex, 0);
+	atomic_init(&fifoIn->removeIndex, 0);
+}
+
+
+bool cxa_fixedFifo_spsc_queue(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemIn)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(elemIn);
+
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_relaxed);
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_acquire);
+	if( getNumElems(fifoIn, insertIndex, removeIndex) >= fifoIn->maxNumElements ) return false;
+
+	// copy in the element, then publish it
+	memcpy(getElemPtr(fifoIn, insertIndex), elemIn, fifoIn->datatypeSize_bytes);
+	atomic_store_explicit(&fifoIn->insertIndex, advanceIndex(fifoIn, insertIndex, 1), memory_order_release);
+
+	return true;
+}
+
+
+size_t cxa_fixedFifo_spsc_bulkQueue(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemsIn, size_t numElemsIn)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(elemsIn || (numElemsIn == 0));
+
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_relaxed);
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_acquire);
+	size_t numFreeElems = fifoIn->maxNumElements - getNumElems(fifoIn, insertIndex, removeIndex);
+	if( numElemsIn > numFreeElems ) numElemsIn = numFreeElems;
+	if( numElemsIn == 0 ) return 0;
+
+	// copy up to the end of the buffer, then wrap around to the beginning
+	size_t insertPos = (insertIndex >= fifoIn->maxNumElements) ? (insertIndex - fifoIn->maxNumElements) : insertIndex;
+	size_t numElems_seg1 = fifoIn->maxNumElements - insertPos;
+	if( numElems_seg1 > numElemsIn ) numElems_seg1 = numElemsIn;
+
+	memcpy(getElemPtr(fifoIn, insertIndex), elemsIn, numElems_seg1 * fifoIn->datatypeSize_bytes);
+	memcpy(fifoIn->bufferLoc, ((uint8_t*)elemsIn) + (numElems_seg1 * fifoIn->datatypeSize_bytes), (numElemsIn - numElems_seg1) * fifoIn->datatypeSize_bytes);
+
+	// publish them all at once
+	atomic_store_explicit(&fifoIn->insertIndex, advanceIndex(fifoIn, insertIndex, numElemsIn), memory_order_release);
+
+	return numElemsIn;
+}
+
+
+size_t cxa_fixedFifo_spsc_bulkQueue_reserve(cxa_fixedFifo_spsc_t *const fifoIn, void **const elemsOut)
+{
+	cxa_assert(fifoIn);
+
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_relaxed);
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_acquire);
+	size_t numFreeElems = fifoIn->maxNumElements - getNumElems(fifoIn, insertIndex, removeIndex);
+
+	if( elemsOut != NULL ) *elemsOut = getElemPtr(fifoIn, insertIndex);
+
+	// only up to the end of the buffer
+	size_t insertPos = (insertIndex >= fifoIn->maxNumElements) ? (insertIndex - fifoIn->maxNumElements) : insertIndex;
+	size_t numElems_untilWrap = fifoIn->maxNumElements - insertPos;
+	return (numFreeElems < numElems_untilWrap) ? numFreeElems : numElems_untilWrap;
+}
+
+
+bool cxa_fixedFifo_spsc_bulkQueue_commit(cxa_fixedFifo_spsc_t *const fifoIn, size_t numElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	bool retVal = true;
+	size_t numElems_reserved = cxa_fixedFifo_spsc_bulkQueue_reserve(fifoIn, NULL);
+	if( numElemsIn > numElems_reserved )
+	{
+		numElemsIn = numElems_reserved;
+		retVal = false;
+	}
+
+	// publish them all at once
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_relaxed);
+	atomic_store_explicit(&fifoIn->insertIndex, advanceIndex(fifoIn, insertIndex, numElemsIn), memory_order_release);
+
+	return retVal;
+}
+
+
+bool cxa_fixedFifo_spsc_dequeue(cxa_fixedFifo_spsc_t *const fifoIn, void *elemOut)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_relaxed);
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	if( insertIndex == removeIndex ) return false;
+
+	// copy out the element, then free its space
+	if( elemOut != NULL ) memcpy(elemOut, getElemPtr(fifoIn, removeIndex), fifoIn->datatypeSize_bytes);
+	atomic_store_explicit(&fifoIn->removeIndex, advanceIndex(fifoIn, removeIndex, 1), memory_order_release);
+
+	return true;
+}
+
+
+size_t cxa_fixedFifo_spsc_bulkDequeue_copy(cxa_fixedFifo_spsc_t *const fifoIn, void *const elemsOut, size_t maxNumElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_relaxed);
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	size_t numElems = getNumElems(fifoIn, insertIndex, removeIndex);
+	if( numElems > maxNumElemsIn ) numElems = maxNumElemsIn;
+	if( numElems == 0 ) return 0;
+
+	if( elemsOut != NULL )
+	{
+		// copy up to the end of the buffer, then wrap around to the beginning
+		size_t removePos = (removeIndex >= fifoIn->maxNumElements) ? (removeIndex - fifoIn->maxNumElements) : removeIndex;
+		size_t numElems_seg1 = fifoIn->maxNumElements - removePos;
+		if( numElems_seg1 > numElems ) numElems_seg1 = numElems;
+
+		memcpy(elemsOut, getElemPtr(fifoIn, removeIndex), numElems_seg1 * fifoIn->datatypeSize_bytes);
+		memcpy(((uint8_t*)elemsOut) + (numElems_seg1 * fifoIn->datatypeSize_bytes), fifoIn->bufferLoc, (numElems - numElems_seg1) * fifoIn->datatypeSize_bytes);
+	}
+
+	// free their space
+	atomic_store_explicit(&fifoIn->removeIndex, advanceIndex(fifoIn, removeIndex, numElems), memory_order_release);
+
+	return numElems;
+}
+
+
+size_t cxa_fixedFifo_spsc_bulkDequeue_peek(cxa_fixedFifo_spsc_t *const fifoIn, void **const elemsOut)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_relaxed);
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	size_t numElems = getNumElems(fifoIn, insertIndex, removeIndex);
+
+	if( elemsOut != NULL ) *elemsOut = getElemPtr(fifoIn, removeIndex);
+
+	// only up to the end of the buffer
+	size_t removePos = (removeIndex >= fifoIn->maxNumElements) ? (removeIndex - fifoIn->maxNumElements) : removeIndex;
+	size_t numElems_untilWrap = fifoIn->maxNumElements - removePos;
+	return (numElems < numElems_untilWrap) ? numElems : numElems_untilWrap;
+}
+
+
+bool cxa_fixedFifo_spsc_bulkDequeue(cxa_fixedFifo_spsc_t *const fifoIn, size_t numElemsIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_relaxed);
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+
+	bool retVal = true;
+	size_t numElems = getNumElems(fifoIn, insertIndex, removeIndex);
+	if( numElemsIn > numElems )
+	{
+		numElemsIn = numElems;
+		retVal = false;
+	}
+
+	// free their space
+	atomic_store_explicit(&fifoIn->removeIndex, advanceIndex(fifoIn, removeIndex, numElemsIn), memory_order_release);
+
+	return retVal;
+}
+
+
+void cxa_fixedFifo_spsc_clear(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	cxa_assert(fifoIn);
+
+	// discard everything the producer has published so far
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	atomic_store_explicit(&fifoIn->removeIndex, insertIndex, memory_order_release);
+}
+
+
+size_t cxa_fixedFifo_spsc_getSize_elems(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_acquire);
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	return getNumElems(fifoIn, insertIndex, removeIndex);
+}
+
+
+size_t cxa_fixedFifo_spsc_getFreeSize_elems(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	cxa_assert(fifoIn);
+
+	size_t insertIndex = atomic_load_explicit(&fifoIn->insertIndex, memory_order_acquire);
+	size_t removeIndex = atomic_load_explicit(&fifoIn->removeIndex, memory_order_acquire);
+	return fifoIn->maxNumElements - getNumElems(fifoIn, insertIndex, removeIndex);
+}
+
+
+size_t cxa_fixedFifo_spsc_getMaxSize_elems(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	cxa_assert(fifoIn);
+
+	return fifoIn->maxNumElements;
+}
+
+
+bool cxa_fixedFifo_spsc_isFull(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	return (cxa_fixedFifo_spsc_getFreeSize_elems(fifoIn) == 0);
+}
+
+
+bool cxa_fixedFifo_spsc_isEmpty(cxa_fixedFifo_spsc_t *const fifoIn)
+{
+	return (cxa_fixedFifo_spsc_getSize_elems(fifoIn) == 0);
+}
+
+
+// ******** local function implementations ********
+static inline size_t advanceIndex(cxa_fixedFifo_spsc_t *const fifoIn, size_t indexIn, size_t numElemsIn)
+{
+	size_t retVal = indexIn + numElemsIn;
+	return (retVal >= (2 * fifoIn->maxNumElements)) ? (retVal - (2 * fifoIn->maxNumElements)) : retVal;
+}
+
+
+static inline size_t getNumElems(cxa_fixedFifo_spsc_t *const fifoIn, size_t insertIndexIn, size_t removeIndexIn)
+{
+	return (insertIndexIn >= removeIndexIn) ? (insertIndexIn - removeIndexIn) : ((2 * fifoIn->maxNumElements) - removeIndexIn + insertIndexIn);
+}
+
+
+static inline uint8_t* getElemPtr(cxa_fixedFifo_spsc_t *const fifoIn, size_t indexIn)
+{
+	size_t pos = (indexIn >= fifoIn->maxNumElements) ? (indexIn - fifoIn->maxNumElements) : indexIn;
+	return ((uint8_t*)fifoIn->bufferLoc) + (pos * fifoIn->datatypeSize_bytes);
+}
@@ -0,0 +1,332 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_hashMap.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <string.h>
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define FNV1A_OFFSET_BASIS					2166136261u
+#define FNV1A_PRIME							16777619u
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void init_common(cxa_hashMap_t *const mapIn, const size_t keySize_bytesIn, const size_t valueSize_bytesIn,
+						void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn);
+static bool hashKey(cxa_hashMap_t *const mapIn, const void *const keyIn, uint32_t *const hashOut);
+static bool findSlot(cxa_hashMap_t *const mapIn, const void *const keyIn, const uint32_t hashIn, size_t *const indexOut);
+
+static inline cxa_hashMap_slotHeader_t* getSlot(cxa_hashMap_t *const mapIn, const size_t indexIn);
+static inline void* getSlotKey(cxa_hashMap_t *const mapIn, const size_t indexIn);
+static inline void* getSlotValue(cxa_hashMap_t *const mapIn, const size_t indexIn);
+static inline size_t getProbeDistance(cxa_hashMap_t *const mapIn, const size_t indexIn);
+static inline size_t nextIndex(cxa_hashMap_t *const mapIn, const size_t indexIn);
+static inline size_t prevIndex(cxa_hashMap_t *const mapIn, const size_t indexIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_hashMap_init(cxa_hashMap_t *const mapIn, const size_t keySize_bytesIn, const size_t valueSize_bytesIn,
+					  void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+					  cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn)
+{
+	init_common(mapIn, keySize_bytesIn, valueSize_bytesIn, bufferLocIn, bufferMaxSize_bytesIn, cb_hashIn, userVarIn);
+	mapIn->hasStringKeys = false;
+}
+
+
+void cxa_hashMap_init_stringKeys(cxa_hashMap_t *const mapIn, const size_t maxKeyLen_bytesIn, const size_t valueSize_bytesIn,
+								 void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+								 cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn)
+{
+	// leave room for the terminator
+	init_common(mapIn, maxKeyLen_bytesIn+1, valueSize_bytesIn, bufferLocIn, bufferMaxSize_bytesIn, cb_hashIn, userVarIn);
+	mapIn->hasStringKeys = true;
+}
+
+
+bool cxa_hashMap_put(cxa_hashMap_t *const mapIn, const void *const keyIn, void *const valueIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(valueIn);
+
+	void* valueLoc = cxa_hashMap_put_empty(mapIn, keyIn);
+	if( valueLoc == NULL ) return false;
+
+	memcpy(valueLoc, valueIn, mapIn->valueSize_bytes);
+	return true;
+}
+
+
+void* cxa_hashMap_put_empty(cxa_hashMap_t *const mapIn, const void *const keyIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(keyIn);
+
+	uint32_t hash;
+	if( !hashKey(mapIn, keyIn, &hash) ) return NULL;
+
+	// see if we already have this key
+	size_t insertIndex;
+	if( findSlot(mapIn, keyIn, hash, &insertIndex) ) return getSlotValue(mapIn, insertIndex);
+	if( mapIn->numEntries >= mapIn->numSlots ) return NULL;
+
+	// findSlot stopped where the key belongs (an empty slot or the first entry
+	// closer to its home slot), shift that entry and the rest of its run down
+	// to the next empty slot to make room
+	size_t emptyIndex = insertIndex;
+	while( getSlot(mapIn, emptyIndex)->isUsed ) emptyIndex = nextIndex(mapIn, emptyIndex);
+	while( emptyIndex != insertIndex )
+	{
+		size_t srcIndex = prevIndex(mapIn, emptyIndex);
+		memcpy(getSlot(mapIn, emptyIndex), getSlot(mapIn, srcIndex), mapIn->slotSize_bytes);
+		emptyIndex = srcIndex;
+	}
+
+	// now fill in our new entry
+	cxa_hashMap_slotHeader_t* newSlot = getSlot(mapIn, insertIndex);
+	newSlot->hash = hash;
+	newSlot->isUsed = true;
+	if( mapIn->hasStringKeys )
+	{
+		memset(getSlotKey(mapIn, insertIndex), 0, mapIn->keySize_bytes);
+		strcpy((char*)getSlotKey(mapIn, insertIndex), (const char*)keyIn);
+	}
+	else memcpy(getSlotKey(mapIn, insertIndex), keyIn, mapIn->keySize_bytes);
+	mapIn->numEntries++;
+
+	return getSlotValue(mapIn, insertIndex);
+}
+
+
+void* cxa_hashMap_get(cxa_hashMap_t *const mapIn, const void *const keyIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(keyIn);
+
+	uint32_t hash;
+	size_t index;
+	if( !hashKey(mapIn, keyIn, &hash) || !findSlot(mapIn, keyIn, hash, &index) ) return NULL;
+
+	return getSlotValue(mapIn, index);
+}
+
+
+bool cxa_hashMap_remove(cxa_hashMap_t *const mapIn, const void *const keyIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(keyIn);
+
+	uint32_t hash;
+	size_t index;
+	if( !hashKey(mapIn, keyIn, &hash) || !findSlot(mapIn, keyIn, hash, &index) ) return false;
+
+	// shift following entries (that aren't in their home slot) back by one
+	// so no tombstone is needed
+	size_t nextIdx = nextIndex(mapIn, index);
+	while( getSlot(mapIn, nextIdx)->isUsed && (getProbeDistance(mapIn, nextIdx) > 0) )
+	{
+		memcpy(getSlot(mapIn, index), getSlot(mapIn, nextIdx), mapIn->slotSize_bytes);
+		index = nextIdx;
+		nextIdx = nextIndex(mapIn, nextIdx);
+	}
+	getSlot(mapIn, index)->isUsed = false;
+	mapIn->numEntries--;
+
+	return true;
+}
+
+
+void cxa_hashMap_clear(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	for( size_t i = 0; i < mapIn->numSlots; i++ )
+	{
+		getSlot(mapIn, i)->isUsed = false;
+	}
+	mapIn->numEntries = 0;
+}
+
+
+size_t cxa_hashMap_getSize_elems(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return mapIn->numEntries;
+}
+
+
+size_t cxa_hashMap_getMaxSize_elems(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return mapIn->numSlots;
+}
+
+
+bool cxa_hashMap_isFull(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return (mapIn->numEntries >= mapIn->numSlots);
+}
+
+
+bool cxa_hashMap_isEmpty(cxa_hashMap_t *const mapIn)
+{
+	cxa_assert(mapIn);
+
+	return (mapIn->numEntries == 0);
+}
+
+
+uint32_t cxa_hashMap_hash_fnv1a(const void *const keyIn, const size_t keySize_bytesIn, void *const userVarIn)
+{
+	cxa_assert(keyIn || (keySize_bytesIn == 0));
+
+	uint32_t retVal = FNV1A_OFFSET_BASIS;
+	for( size_t i = 0; i < keySize_bytesIn; i++ )
+	{
+		retVal ^= ((const uint8_t*)keyIn)[i];
+		retVal *= FNV1A_PRIME;
+	}
+
+	return retVal;
+}
+
+
+// ******** local function implementations ********
+static void init_common(cxa_hashMap_t *const mapIn, const size_t keySize_bytesIn, const size_t valueSize_bytesIn,
+						void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						cxa_hashMap_cb_hash_t cb_hashIn, void *const userVarIn)
+{
+	cxa_assert(mapIn);
+	cxa_assert(keySize_bytesIn > 0);
+	cxa_assert(bufferLocIn);
+	cxa_assert_msg((((uintptr_t)bufferLocIn) % CXA_HASHMAP_ALIGNMENT_BYTES) == 0, "buffer must be aligned");
+
+	// save our references
+	mapIn->bufferLoc = bufferLocIn;
+	mapIn->keySize_bytes = keySize_bytesIn;
+	mapIn->valueSize_bytes = valueSize_bytesIn;
+	mapIn->cb_hash = (cb_hashIn != NULL) ? cb_hashIn : cxa_hashMap_hash_fnv1a;
+	mapIn->userVar = userVarIn;
+
+	// layout of each slot: header, key, value
+	mapIn->keyOffset_bytes = CXA_HASHMAP_ALIGN(sizeof(cxa_hashMap_slotHeader_t));
+	mapIn->valueOffset_bytes = mapIn->keyOffset_bytes + CXA_HASHMAP_ALIGN(keySize_bytesIn);
+	mapIn->slotSize_bytes = CXA_HASHMAP_SLOT_SIZE_BYTES(keySize_bytesIn, valueSize_bytesIn);
+	mapIn->numSlots = bufferMaxSize_bytesIn / mapIn->slotSize_bytes;
+	cxa_assert(mapIn->numSlots > 0);
+
+	cxa_hashMap_clear(mapIn);
+}
+
+
+static bool hashKey(cxa_hashMap_t *const mapIn, const void *const keyIn, uint32_t *const hashOut)
+{
+	size_t keySize_bytes = mapIn->keySize_bytes;
+	if( mapIn->hasStringKeys )
+	{
+		// must fit (along with its terminator)
+		keySize_bytes = strnlen((const char*)keyIn, mapIn->keySize_bytes);
+		if( keySize_bytes >= mapIn->keySize_bytes ) return false;
+	}
+
+	*hashOut = mapIn->cb_hash(keyIn, keySize_bytes, mapIn->userVar);
+	return true;
+}
+
+
+static bool findSlot(cxa_hashMap_t *const mapIn, const void *const keyIn, const uint32_t hashIn, size_t *const indexOut)
+{
+	size_t index = hashIn % mapIn->numSlots;
+	for( size_t dist = 0; dist < mapIn->numSlots; dist++ )
+	{
+		cxa_hashMap_slotHeader_t* currSlot = getSlot(mapIn, index);
+
+		// entries are ordered by distance from their home slot, so if we reach an
+		// empty slot or one that is closer to home than we are, the key isn't here
+		if( !currSlot->isUsed || (getProbeDistance(mapIn, index) < dist) ) break;
+
+		if( (currSlot->hash == hashIn) &&
+			(mapIn->hasStringKeys ?
+				(strcmp((const char*)getSlotKey(mapIn, index), (const char*)keyIn) == 0) :
+				(memcmp(getSlotKey(mapIn, index), keyIn, mapIn->keySize_bytes) == 0)) )
+		{
+			*indexOut = index;
+			return true;
+		}
+
+		index = nextIndex(mapIn, index);
+	}
+
+	// where the key would be inserted
+	*indexOut = index;
+	return false;
+}
+
+
+static inline cxa_hashMap_slotHeader_t* getSlot(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	return (cxa_hashMap_slotHeader_t*)(((uint8_t*)mapIn->bufferLoc) + (indexIn * mapIn->slotSize_bytes));
+}
+
+
+static inline void* getSlotKey(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	return ((uint8_t*)getSlot(mapIn, indexIn)) + mapIn->keyOffset_bytes;
+}
+
+
+static inline void* getSlotValue(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	return ((uint8_t*)getSlot(mapIn, indexIn)) + mapIn->valueOffset_bytes;
+}
+
+
+static inline size_t getProbeDistance(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	size_t homeIndex = getSlot(mapIn, indexIn)->hash % mapIn->numSlots;
+	return (indexIn >= homeIndex) ? (indexIn - homeIndex) : (mapIn->numSlots - homeIndex + indexIn);
+}
+
+
+static inline size_t nextIndex(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	return ((indexIn + 1) < mapIn->numSlots) ? (indexIn + 1) : 0;
+}
+
+
+static inline size_t prevIndex(cxa_hashMap_t *const mapIn, const size_t indexIn)
+{
+	return (indexIn > 0) ? (indexIn - 1) : (mapIn->numSlots - 1);
+}
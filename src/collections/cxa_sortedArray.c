@@ -0,0 +1,130 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_sortedArray.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static size_t upperBound(cxa_sortedArray_t *const arrIn, const void *const keyIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_sortedArray_init(cxa_sortedArray_t *const arrIn, const size_t datatypeSize_bytesIn, void *const bufferLocIn, const size_t bufferMaxSize_bytesIn,
+						  cxa_sortedArray_cb_compare_t cb_compareIn, void *const userVarIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(cb_compareIn);
+
+	// save our references
+	cxa_array_init(&arrIn->array, datatypeSize_bytesIn, bufferLocIn, bufferMaxSize_bytesIn);
+	arrIn->cb_compare = cb_compareIn;
+	arrIn->userVar = userVarIn;
+}
+
+
+bool cxa_sortedArray_insertSorted(cxa_sortedArray_t *const arrIn, void *const itemLocIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(itemLocIn);
+
+	// after any equal elements (so insertion order is preserved)
+	return cxa_array_insert(&arrIn->array, upperBound(arrIn, itemLocIn), itemLocIn);
+}
+
+
+size_t cxa_sortedArray_lowerBound(cxa_sortedArray_t *const arrIn, const void *const keyIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(keyIn);
+
+	size_t lo = 0;
+	size_t hi = cxa_array_getSize_elems(&arrIn->array);
+	while( lo < hi )
+	{
+		size_t mid = lo + ((hi - lo) / 2);
+		if( arrIn->cb_compare(keyIn, cxa_array_get_noBoundsCheck(&arrIn->array, mid), arrIn->userVar) > 0 ) lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo;
+}
+
+
+void* cxa_sortedArray_find(cxa_sortedArray_t *const arrIn, const void *const keyIn, size_t *const indexOut)
+{
+	cxa_assert(arrIn);
+	cxa_assert(keyIn);
+
+	size_t index = cxa_sortedArray_lowerBound(arrIn, keyIn);
+	void* retVal = cxa_array_get(&arrIn->array, index);
+	if( (retVal == NULL) || (arrIn->cb_compare(keyIn, retVal, arrIn->userVar) != 0) ) return NULL;
+
+	if( indexOut != NULL ) *indexOut = index;
+	return retVal;
+}
+
+
+bool cxa_sortedArray_removeKey(cxa_sortedArray_t *const arrIn, const void *const keyIn)
+{
+	cxa_assert(arrIn);
+	cxa_assert(keyIn);
+
+	size_t index;
+	if( cxa_sortedArray_find(arrIn, keyIn, &index) == NULL ) return false;
+
+	return cxa_array_remove_atIndex(&arrIn->array, index);
+}
+
+
+cxa_array_t* cxa_sortedArray_getArray(cxa_sortedArray_t *const arrIn)
+{
+	cxa_assert(arrIn);
+
+	return &arrIn->array;
+}
+
+
+// ******** local function implementations ********
+static size_t upperBound(cxa_sortedArray_t *const arrIn, const void *const keyIn)
+{
+	size_t lo = 0;
+	size_t hi = cxa_array_getSize_elems(&arrIn->array);
+	while( lo < hi )
+	{
+		size_t mid = lo + ((hi - lo) / 2);
+		if( arrIn->cb_compare(keyIn, cxa_array_get_noBoundsCheck(&arrIn->array, mid), arrIn->userVar) >= 0 ) lo = mid + 1;
+		else hi = mid;
+	}
+
+	return lo;
+}
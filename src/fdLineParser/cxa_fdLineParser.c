@@ -22,17 +22,24 @@
 
 
 // ******** includes ********
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+	#include <unistd.h>
+#endif
 #include <cxa_assert.h>
 
 
 // ******** local macro definitions ********
-#define MAX_READ_BYTES_PER_UPDATE			16
 
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
+static size_t readBlock(cxa_fdLineParser_t *const fdlpIn, uint8_t *const buffIn, size_t maxNumBytesIn);
+static bool parseBlock(cxa_fdLineParser_t *const fdlpIn, uint8_t *const bytesIn, size_t numBytesIn);
+static bool appendToLine(cxa_fdLineParser_t *const fdlpIn, uint8_t *bytesIn, size_t numBytesIn);
+static void deliverLine(cxa_fdLineParser_t *const fdlpIn);
 
 
 // ********  local variable declarations *********
@@ -55,6 +62,11 @@ void cxa_fdLineParser_init(cxa_fdLineParser_t *const fdlpIn, FILE *fdIn, bool ec
 	// setup our internal state
 	cxa_array_init(&fdlpIn->lineBuffer, 1, bufferIn, bufferSize_bytesIn);
 	fdlpIn->wasLastByteCr = false;
+	
+#if defined(__unix__) || defined(__APPLE__)
+	// we read the descriptor directly (see readBlock) so stdio must not hold any bytes back from us
+	if( fileno(fdIn) >= 0 ) setvbuf(fdIn, NULL, _IONBF, 0);
+#endif
 }
 
 
@@ -65,45 +77,124 @@ bool cxa_fdLineParser_update(cxa_fdLineParser_t *const fdlpIn)
 	bool retVal = true;
 	
 	// limit how long we'll be in this function
-	for( uint8_t i = 0; i < MAX_READ_BYTES_PER_UPDATE; i++ )
+	size_t numBytesRemaining = CXA_FDLINEPARSER_MAXNUM_BYTES_PER_UPDATE;
+	while( numBytesRemaining > 0 )
+	{
+		// read whatever is available (up to one block)
+		uint8_t block[CXA_FDLINEPARSER_READ_BLOCK_SIZE_BYTES];
+		size_t numBytesToRead = (numBytesRemaining < sizeof(block)) ? numBytesRemaining : sizeof(block);
+		size_t numBytesRead = readBlock(fdlpIn, block, numBytesToRead);
+		if( numBytesRead == 0 ) break;
+		numBytesRemaining -= numBytesRead;
+		
+		// deliver every complete line in this block
+		if( !parseBlock(fdlpIn, block, numBytesRead) ) retVal = false;
+		
+		// a short read means there's nothing more available right now
+		if( numBytesRead < numBytesToRead ) break;
+	}
+	
+	return retVal;
+}
+
+
+// ******** local function implementations ********
+static size_t readBlock(cxa_fdLineParser_t *const fdlpIn, uint8_t *const buffIn, size_t maxNumBytesIn)
+{
+	cxa_assert(fdlpIn);
+	cxa_assert(buffIn);
+	
+#if defined(__unix__) || defined(__APPLE__)
+	// a single read returns whatever is available (rather than waiting for a full block)
+	int fileDesc = fileno(fdlpIn->fd);
+	if( fileDesc >= 0 )
 	{
-		// get a byte from the file descriptor
-		int newChar = fgetc(fdlpIn->fd);
+		ssize_t numBytesRead = read(fileDesc, buffIn, maxNumBytesIn);
+		return (numBytesRead > 0) ? (size_t)numBytesRead : 0;
+	}
+#endif
+	
+	// no descriptor...take bytes until the stream runs dry
+	size_t numBytesRead = 0;
+	while( numBytesRead < maxNumBytesIn )
+	{
+		int newChar = getc(fdlpIn->fd);
 		if( newChar == EOF ) break;
+		buffIn[numBytesRead++] = (uint8_t)newChar;
+	}
+	return numBytesRead;
+}
+
+
+static bool parseBlock(cxa_fdLineParser_t *const fdlpIn, uint8_t *const bytesIn, size_t numBytesIn)
+{
+	cxa_assert(fdlpIn);
+	cxa_assert(bytesIn);
+	
+	bool retVal = true;
+	uint8_t* currPos = bytesIn;
+	uint8_t* endPos = bytesIn + numBytesIn;
+	
+	while( currPos < endPos )
+	{
+		// a LF immediately following a CR is part of a CRLF delimiter
+		if( fdlpIn->wasLastByteCr && (*currPos == '\n') ) currPos++;
+		fdlpIn->wasLastByteCr = false;
+		if( currPos >= endPos ) break;
 		
-		size_t bufferSize_bytes = cxa_array_getSize_elems(&fdlpIn->lineBuffer);
+		// find the next delimiter (whichever of CR or LF comes first)
+		uint8_t* delim = memchr(currPos, '\r', (size_t)(endPos - currPos));
+		uint8_t* lfPos = memchr(currPos, '\n', (size_t)((delim != NULL) ? (delim - currPos) : (endPos - currPos)));
+		if( lfPos != NULL ) delim = lfPos;
 		
-		// we've got a valid byte...see if it's a line delimiter
-		if( (newChar == '\r') || ((newChar == '\n') && !fdlpIn->wasLastByteCr) )
+		// add everything up to the delimiter (or end of block) to our line
+		uint8_t* runEnd = (delim != NULL) ? delim : endPos;
+		if( !appendToLine(fdlpIn, currPos, (size_t)(runEnd - currPos)) ) retVal = false;
+		if( delim == NULL ) break;
+		
+		// we have a complete line
+		deliverLine(fdlpIn);
+		fdlpIn->wasLastByteCr = (*delim == '\r');
+		currPos = delim + 1;
+	}
+	
+	return retVal;
+}
+
+
+static bool appendToLine(cxa_fdLineParser_t *const fdlpIn, uint8_t *bytesIn, size_t numBytesIn)
+{
+	cxa_assert(fdlpIn);
+	
+	bool retVal = true;
+	while( numBytesIn > 0 )
+	{
+		// make sure we have room in our buffer for these bytes
+		// AND a NULL termination upon delimiter
+		size_t numFreeBytes = cxa_array_getFreeSize_elems(&fdlpIn->lineBuffer);
+		size_t numBytesToCopy = (numFreeBytes < 2) ? 0 : (numFreeBytes - 1);
+		if( numBytesToCopy > numBytesIn ) numBytesToCopy = numBytesIn;
+		
+		if( numBytesToCopy > 0 )
 		{
-			// we have a delimiter...terminate our string...this should always be
-			// successful since we are carefully watching our size during appends
-			uint8_t nullChar = 0;
-			cxa_assert(cxa_array_append(&fdlpIn->lineBuffer, &nullChar));
+			size_t currSize_bytes = cxa_array_getSize_elems(&fdlpIn->lineBuffer);
+			memcpy(cxa_array_get_noBoundsCheck(&fdlpIn->lineBuffer, currSize_bytes), bytesIn, numBytesToCopy);
+			cxa_array_init_inPlace(&fdlpIn->lineBuffer, 1, currSize_bytes + numBytesToCopy, cxa_array_get_noBoundsCheck(&fdlpIn->lineBuffer, 0), cxa_array_getMaxSize_elems(&fdlpIn->lineBuffer));
 			
-			// call our callback
-			if( fdlpIn->cb != NULL ) fdlpIn->cb((uint8_t*)cxa_array_get(&fdlpIn->lineBuffer, 0), bufferSize_bytes, fdlpIn->userVar);
+			if( fdlpIn->echoUser ) fwrite(bytesIn, 1, numBytesToCopy, fdlpIn->fd);
 			
-			// clear our buffer
-			cxa_array_clear(&fdlpIn->lineBuffer);
-			fdlpIn->wasLastByteCr = (newChar == '\r');
-			
-			// exit the loop since the callback may have taken some time...
-			break;
+			bytesIn += numBytesToCopy;
+			numBytesIn -= numBytesToCopy;
 		}
-		else if( newChar != '\n' )
+		
+		if( numBytesIn > 0 )
 		{
-			// not a carriage return or line feed...make sure we have room in our buffer
-			// for both this element AND a NULL termination upon delimiter
-			if( (cxa_array_getFreeSize_elems(&fdlpIn->lineBuffer) < 2) || !cxa_array_append(&fdlpIn->lineBuffer, &newChar) )
-			{
-				// received too many characters before a CR, LF, or CRLF
-				// clear our buffer and restart
-				cxa_array_clear(&fdlpIn->lineBuffer);
-				fdlpIn->wasLastByteCr = false;
-				retVal = false;
-			}
-			else if( fdlpIn->echoUser ) fputc(newChar, fdlpIn->fd);
+			// received too many characters before a CR, LF, or CRLF
+			// clear our buffer and restart (dropping the offending character)
+			cxa_array_clear(&fdlpIn->lineBuffer);
+			bytesIn++;
+			numBytesIn--;
+			retVal = false;
 		}
 	}
 	
@@ -111,5 +202,20 @@ bool cxa_fdLineParser_update(cxa_fdLineParser_t *const fdlpIn)
 }
 
 
-// ******** local function implementations ********
-
+static void deliverLine(cxa_fdLineParser_t *const fdlpIn)
+{
+	cxa_assert(fdlpIn);
+	
+	size_t bufferSize_bytes = cxa_array_getSize_elems(&fdlpIn->lineBuffer);
+	
+	// terminate our string...this should always be successful
+	// since we are carefully watching our size during appends
+	uint8_t nullChar = 0;
+	cxa_assert(cxa_array_append(&fdlpIn->lineBuffer, &nullChar));
+	
+	// call our callback
+	if( fdlpIn->cb != NULL ) fdlpIn->cb((uint8_t*)cxa_array_get(&fdlpIn->lineBuffer, 0), bufferSize_bytes, fdlpIn->userVar);
+	
+	// clear our buffer
+	cxa_array_clear(&fdlpIn->lineBuffer);
+}
@@ -37,13 +37,17 @@
 // ******** local macro definitions ********
 #define CXA_LOGGER_TRUNCATE_STRING			"..."
 
+// time + space, name, pointer, level, space
+#define HEADER_MAXLEN_BYTES					(9 + CXA_LOGGER_MAX_NAME_LEN_CHARS + (5+(2*sizeof(void*))) + 5 + 1)
+
 
 // ******** local type definitions ********
 
 
 // ******** local function prototypes ********
 static inline void checkSysLogInit(void);
-static void writeField(const char *const stringIn, size_t maxFieldLenIn);
+static size_t formatField(char *const buffOut, const char *const stringIn, size_t maxFieldLenIn);
+static size_t formatHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn, char *const buffOut);
 static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn);
 
 
@@ -128,15 +132,19 @@ void cxa_logger_log_untermString(cxa_logger_t *const loggerIn, const uint8_t lev
 	cxa_console_prelog();
 #endif
 
-	// common header
-	writeHeader(loggerIn, levelIn);
+	// common header, message, and EOL as a single write
+	char header[HEADER_MAXLEN_BYTES];
+	size_t headerLen_bytes = formatHeader(loggerIn, levelIn, header);
 
-	if( prefixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)prefixIn);
-	cxa_ioStream_writeBytes(ioStream, (void *const)untermStringIn, untermStrLen_bytesIn);
-	if( postFixIn != NULL ) cxa_ioStream_writeString(ioStream, (char *const)postFixIn);
-
-	// print EOL
-	cxa_ioStream_writeString(ioStream, CXA_LINE_ENDING);
+	cxa_ioStream_vector_t vectors[] =
+	{
+		{.buff=header, .size_bytes=headerLen_bytes},
+		{.buff=(void*)prefixIn, .size_bytes=(prefixIn != NULL) ? strlen(prefixIn) : 0},
+		{.buff=(void*)untermStringIn, .size_bytes=untermStrLen_bytesIn},
+		{.buff=(void*)postFixIn, .size_bytes=(postFixIn != NULL) ? strlen(postFixIn) : 0},
+		{.buff=(void*)CXA_LINE_ENDING, .size_bytes=strlen(CXA_LINE_ENDING)}
+	};
+	cxa_ioStream_writeVector(ioStream, vectors, sizeof(vectors)/sizeof(*vectors));
 
 #ifdef CXA_CONSOLE_ENABLE
 	cxa_console_postlog();
@@ -298,29 +306,30 @@ static inline void checkSysLogInit(void)
 }
 
 
-static void writeField(const char *const stringIn, size_t maxFieldLenIn)
+static size_t formatField(char *const buffOut, const char *const stringIn, size_t maxFieldLenIn)
 {
 	size_t stringLen_bytes = strlen(stringIn);
 
 	if( stringLen_bytes > maxFieldLenIn )
 	{
-		cxa_ioStream_writeBytes(ioStream, (void*)stringIn, maxFieldLenIn-strlen(CXA_LOGGER_TRUNCATE_STRING));
-		cxa_ioStream_writeString(ioStream, CXA_LOGGER_TRUNCATE_STRING);
+		size_t numCharsToCopy = maxFieldLenIn-strlen(CXA_LOGGER_TRUNCATE_STRING);
+		memcpy(buffOut, stringIn, numCharsToCopy);
+		memcpy(&buffOut[numCharsToCopy], CXA_LOGGER_TRUNCATE_STRING, strlen(CXA_LOGGER_TRUNCATE_STRING));
 	}
 	else
 	{
-		cxa_ioStream_writeString(ioStream, (char*)stringIn);
-		for( size_t i = stringLen_bytes; i < maxFieldLenIn; i++ )
-		{
-			cxa_ioStream_writeByte(ioStream, ' ');
-		}
+		memcpy(buffOut, stringIn, stringLen_bytes);
+		memset(&buffOut[stringLen_bytes], ' ', maxFieldLenIn - stringLen_bytes);
 	}
+
+	return maxFieldLenIn;
 }
 
 
-static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
+static size_t formatHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn, char *const buffOut)
 {
 	cxa_assert(loggerIn);
+	cxa_assert(buffOut);
 
 	// figure out our level text
 	const char *levelText = "UNKN";
@@ -350,23 +359,37 @@ static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
 	// our buffer for this go-round max...our pointer size
 	// plus [0x] plus null-term
 	char buff[sizeof(loggerIn)*2 + 4 + 1];
+	size_t headerLen_bytes = 0;
 
 	// print the time (if enabled)
 	#ifdef CXA_LOGGER_TIME_ENABLE
 		snprintf(buff, sizeof(buff), "%-8" PRIx32, cxa_timeBase_getCount_us());
 		// 32-bit integer +space
-		writeField(buff, 9);
+		headerLen_bytes += formatField(&buffOut[headerLen_bytes], buff, 9);
 	#endif
 
 
 	// print the name
-	writeField(loggerIn->name, largestloggerName_bytes);
+	headerLen_bytes += formatField(&buffOut[headerLen_bytes], loggerIn->name, largestloggerName_bytes);
 
 	// pointer (id of logger)
 	snprintf(buff, sizeof(buff), "[%p]", loggerIn);
-	writeField(buff, 5+(2*sizeof(void*)));
+	headerLen_bytes += formatField(&buffOut[headerLen_bytes], buff, 5+(2*sizeof(void*)));
 
 	// level text
-	writeField(levelText, 5);
-	cxa_ioStream_writeByte(ioStream, ' ');
+	headerLen_bytes += formatField(&buffOut[headerLen_bytes], levelText, 5);
+	buffOut[headerLen_bytes++] = ' ';
+
+	return headerLen_bytes;
+}
+
+
+static void writeHeader(cxa_logger_t *const loggerIn, const uint8_t levelIn)
+{
+	cxa_assert(loggerIn);
+
+	char header[HEADER_MAXLEN_BYTES];
+	size_t headerLen_bytes = formatHeader(loggerIn, levelIn, header);
+
+	cxa_ioStream_writeBytes(ioStream, header, headerLen_bytes);
 }
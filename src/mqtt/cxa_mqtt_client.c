@@ -72,10 +72,18 @@ static bool doesTopicMatchFilter(char* topicIn, char* filterIn);
 
 // ******** global function implementations ********
 void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *const iosIn, uint16_t keepAliveTimeout_sIn, char *const clientIdIn)
+{
+	cxa_mqtt_client_init_withRunLoop(clientIn, iosIn, keepAliveTimeout_sIn, clientIdIn, cxa_runLoop_getDefault());
+}
+
+
+void cxa_mqtt_client_init_withRunLoop(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *const iosIn, uint16_t keepAliveTimeout_sIn, char *const clientIdIn,
+									  cxa_runLoop_t *const rlIn)
 {
 	cxa_assert(clientIn);
 	cxa_assert(iosIn);
 	cxa_assert(clientIdIn);
+	cxa_assert(rlIn);
 
 	// save our references
 	clientIn->clientId = clientIdIn;
@@ -92,7 +100,7 @@ void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *con
 	cxa_assert(msg);
 
 	// setup our protocol parser
-	cxa_protocolParser_mqtt_init(&clientIn->mpp, iosIn, msg->buffer);
+	cxa_protocolParser_mqtt_init_withRunLoop(&clientIn->mpp, iosIn, msg->buffer, rlIn);
 	cxa_protocolParser_addProtocolListener(&clientIn->mpp.super, protoParseCb_onIoException, NULL, (void*)clientIn);
 	cxa_protocolParser_addPacketListener(&clientIn->mpp.super, protoParseCb_onPacketReceived, (void*)clientIn);
 
@@ -111,7 +119,7 @@ void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *con
 	clientIn->will.payloadLen_bytes = 0;
 
 	// setup our state machine
-	cxa_stateMachine_init(&clientIn->stateMachine, "mqttClient");
+	cxa_stateMachine_init_withRunLoop(&clientIn->stateMachine, "mqttClient", rlIn);
 	cxa_stateMachine_addState(&clientIn->stateMachine, MQTT_STATE_IDLE, "idle", stateCb_idle_enter, NULL, NULL, (void*)clientIn);
 	cxa_stateMachine_addState(&clientIn->stateMachine, MQTT_STATE_CONNECTING_TRANSPORT, "connectingTransport", NULL, NULL, NULL, (void*)clientIn);
 	cxa_stateMachine_addState(&clientIn->stateMachine, MQTT_STATE_CONNECTING, "connecting", stateCb_connecting_enter, stateCb_connecting_state, NULL, (void*)clientIn);
@@ -120,6 +128,14 @@ void cxa_mqtt_client_init(cxa_mqtt_client_t *const clientIn, cxa_ioStream_t *con
 }
 
 
+cxa_runLoop_t* cxa_mqtt_client_getRunLoop(cxa_mqtt_client_t *const clientIn)
+{
+	cxa_assert(clientIn);
+
+	return clientIn->stateMachine.runLoop;
+}
+
+
 bool cxa_mqtt_client_setWillMessage(cxa_mqtt_client_t *const clientIn, cxa_mqtt_qosLevel_t qosIn, bool retainIn,
 									char* topicNameIn, void *const payloadIn, size_t payloadLen_bytesIn)
 {
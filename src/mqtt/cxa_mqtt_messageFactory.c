@@ -20,6 +20,7 @@
 #include <stddef.h>
 #include <cxa_array.h>
 #include <cxa_assert.h>
+#include <cxa_criticalSection.h>
 
 #define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
 #include <cxa_logger_implementation.h>
@@ -60,12 +61,14 @@ size_t cxa_mqtt_messageFactory_getNumFreeMessages(void)
 	initIfNeeded();
 
 	size_t numFreeMessages = 0;
+	cxa_criticalSection_enter();
 	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
 	{
 		if( currEntry == NULL ) continue;
 
 		if( currEntry->refCount == 0 ) numFreeMessages++;
 	}
+	cxa_criticalSection_exit();
 
 	return numFreeMessages;
 }
@@ -75,6 +78,10 @@ cxa_mqtt_message_t* cxa_mqtt_messageFactory_getFreeMessage_empty(void)
 {
 	initIfNeeded();
 
+	// reserve the message inside the critical section (so two run
+	// loops can't claim the same message)...initialize it outside
+	messageEntry_t* reservedEntry = NULL;
+	cxa_criticalSection_enter();
 	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
 	{
 		if( currEntry == NULL) continue;
@@ -82,16 +89,22 @@ cxa_mqtt_message_t* cxa_mqtt_messageFactory_getFreeMessage_empty(void)
 		if( currEntry->refCount == 0 )
 		{
 			currEntry->refCount = 1;
-			cxa_logger_trace(&logger, "message %p newly reserved", &currEntry->msg);
-
-			cxa_fixedByteBuffer_clear(&currEntry->msgFbb);
-			cxa_mqtt_message_initEmpty(&currEntry->msg, &currEntry->msgFbb);
-			return &currEntry->msg;
+			reservedEntry = currEntry;
+			break;
 		}
 	}
+	cxa_criticalSection_exit();
 
-	cxa_logger_warn(&logger, "no free messages!");
-	return NULL;
+	if( reservedEntry == NULL )
+	{
+		cxa_logger_warn(&logger, "no free messages!");
+		return NULL;
+	}
+	cxa_logger_trace(&logger, "message %p newly reserved", &reservedEntry->msg);
+
+	cxa_fixedByteBuffer_clear(&reservedEntry->msgFbb);
+	cxa_mqtt_message_initEmpty(&reservedEntry->msg, &reservedEntry->msgFbb);
+	return &reservedEntry->msg;
 }
 
 
@@ -102,15 +115,22 @@ cxa_mqtt_message_t* cxa_mqtt_messageFactory_getMessage_byBuffer(cxa_fixedByteBuf
 	// simple case (better than an assert in this case)
 	if( fbbIn == NULL) return NULL;
 
+	cxa_mqtt_message_t* retVal = NULL;
+	cxa_criticalSection_enter();
 	cxa_array_iterate(&msgEntries, currEntry, messageEntry_t)
 	{
 		if( currEntry == NULL) continue;
 
-		if( (currEntry->refCount != 0) && (&currEntry->msgFbb == fbbIn) ) return &currEntry->msg;
+		if( (currEntry->refCount != 0) && (&currEntry->msgFbb == fbbIn) )
+		{
+			retVal = &currEntry->msg;
+			break;
+		}
 	}
+	cxa_criticalSection_exit();
 
-	// if we made it here, we couldn't find a match
-	return NULL;
+	// NULL if we couldn't find a match
+	return retVal;
 }
 
 
@@ -119,9 +139,14 @@ void cxa_mqtt_messageFactory_incrementMessageRefCount(cxa_mqtt_message_t *const
 	initIfNeeded();
 
 	messageEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
-	cxa_assert( targetEntry && (targetEntry->refCount < UINT8_MAX) );
+	cxa_assert(targetEntry);
+
+	cxa_criticalSection_enter();
+	bool canIncrement = (targetEntry->refCount < UINT8_MAX);
+	if( canIncrement ) targetEntry->refCount++;
+	cxa_criticalSection_exit();
+	cxa_assert(canIncrement);
 
-	targetEntry->refCount++;
 	cxa_logger_trace(&logger, "message %p referenced (%d)", &targetEntry->msg, targetEntry->refCount);
 }
 
@@ -133,11 +158,12 @@ void cxa_mqtt_messageFactory_decrementMessageRefCount(cxa_mqtt_message_t *const
 	messageEntry_t* targetEntry = getMsgEntryFromMessage(msgIn);
 	cxa_assert(targetEntry);
 
-	if( targetEntry->refCount > 0 )
-	{
-		targetEntry->refCount--;
-		cxa_logger_trace(&logger, "message %p dereferenced (%d)", &targetEntry->msg, targetEntry->refCount);
-	}
+	cxa_criticalSection_enter();
+	bool wasReferenced = (targetEntry->refCount > 0);
+	if( wasReferenced ) targetEntry->refCount--;
+	cxa_criticalSection_exit();
+
+	if( wasReferenced ) cxa_logger_trace(&logger, "message %p dereferenced (%d)", &targetEntry->msg, targetEntry->refCount);
 	else cxa_logger_warn(&logger, "mismatched decrement call for %p", &targetEntry->msg);
 }
 
@@ -156,7 +182,12 @@ uint8_t cxa_mqtt_messageFactory_getReferenceCountForMessage(cxa_mqtt_message_t *
 // ******** local function implementations ********
 static void initIfNeeded(void)
 {
-	if( isInit ) return;
+	cxa_criticalSection_enter();
+	if( isInit )
+	{
+		cxa_criticalSection_exit();
+		return;
+	}
 
 	// initialize our logger
 	cxa_logger_init(&logger, "mqttMsgFactory");
@@ -171,8 +202,8 @@ static void initIfNeeded(void)
 		currEntry->refCount = 0;
 	}
 
-
 	isInit = true;
+	cxa_criticalSection_exit();
 }
 
 
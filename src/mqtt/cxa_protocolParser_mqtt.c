@@ -23,6 +23,7 @@
 #include <cxa_assert.h>
 #include <cxa_mqtt_message.h>
 #include <cxa_mqtt_messageFactory.h>
+#include <cxa_numberUtils.h>
 
 #define CXA_LOG_LEVEL			CXA_LOG_LEVEL_INFO
 #include <cxa_logger_implementation.h>
@@ -58,18 +59,29 @@ static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuf
 static void rxState_cb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void *userVarIn);
-static void rxStateCb_waitFixedHeader1_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxStateCb_waitRemainingLen_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxStateCb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void rxStateCb_receiving_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void rxStateCb_processPacket_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void rxState_cb_error_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 
+static void timerCb_onReceptionTimeout(cxa_timer_t *const timerIn, void* userVarIn);
+
+static cxa_ioStream_readStatus_t rxFixedHeader1(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn);
+static cxa_ioStream_readStatus_t rxRemainingLen(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn);
+static cxa_ioStream_readStatus_t rxDataBytes(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn);
+
 
 // ********  local variable declarations *********
 
 
 // ******** global function implementations ********
 void cxa_protocolParser_mqtt_init(cxa_protocolParser_mqtt_t *const mppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn)
+{
+	cxa_protocolParser_mqtt_init_withRunLoop(mppIn, ioStreamIn, buffIn, cxa_runLoop_getDefault());
+}
+
+
+void cxa_protocolParser_mqtt_init_withRunLoop(cxa_protocolParser_mqtt_t *const mppIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
+											  cxa_runLoop_t *const rlIn)
 {
 	cxa_assert(mppIn);
 	cxa_assert(ioStreamIn);
@@ -81,14 +93,18 @@ void cxa_protocolParser_mqtt_init(cxa_protocolParser_mqtt_t *const mppIn, cxa_io
 	mppIn->remainingBytesToReceive = 0;
 
 	// setup our state machine
-	cxa_stateMachine_init(&mppIn->stateMachine, "mqttProtoParser");
+	cxa_stateMachine_init_withRunLoop(&mppIn->stateMachine, "mqttProtoParser", rlIn);
 	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_IDLE, "idle", rxState_cb_idle_enter, rxState_cb_idle_state, rxState_cb_idle_leave, (void*)mppIn);
-	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1, "wait_fh1", NULL, rxStateCb_waitFixedHeader1_state, NULL, (void*)mppIn);
-	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_REMAINING_LEN, "wait_remLen", NULL, rxStateCb_waitRemainingLen_state, NULL, (void*)mppIn);
-	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_DATABYTES, "wait_dataBytes", NULL, rxStateCb_waitDataBytes_state, NULL, (void*)mppIn);
+	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1, "wait_fh1", NULL, rxStateCb_receiving_state, NULL, (void*)mppIn);
+	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_REMAINING_LEN, "wait_remLen", NULL, rxStateCb_receiving_state, NULL, (void*)mppIn);
+	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_WAIT_DATABYTES, "wait_dataBytes", NULL, rxStateCb_receiving_state, NULL, (void*)mppIn);
 	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", rxStateCb_processPacket_enter, NULL, NULL, (void*)mppIn);
 	cxa_stateMachine_addState(&mppIn->stateMachine, RX_STATE_ERROR, "error", rxState_cb_error_enter, NULL, NULL, (void*)mppIn);
 	cxa_stateMachine_setInitialState(&mppIn->stateMachine, RX_STATE_IDLE);
+
+	// if our ioStream tells us when data arrives, we only need to wake for reception timeouts
+	cxa_timer_init_withRunLoop(&mppIn->timer_receptionTimeout, rlIn, timerCb_onReceptionTimeout, (void*)mppIn);
+	if( cxa_ioStream_signalsReadable(ioStreamIn) ) cxa_stateMachine_setEventDriven(&mppIn->stateMachine, true);
 }
 
 
@@ -157,6 +173,9 @@ static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarI
 		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
 		return;
 	}
+
+	// nothing tells us when we get a buffer...keep checking
+	cxa_runLoop_instance_signalMoreWork(mppIn->stateMachine.runLoop);
 }
 
 
@@ -169,195 +188,249 @@ static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateI
 }
 
 
-static void rxStateCb_waitFixedHeader1_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxStateCb_receiving_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 {
 	cxa_protocolParser_mqtt_t *mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
 	cxa_assert(mppIn);
 
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(mppIn->super.ioStream, &rxByte);
-	if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+	// our ioStream may only start telling us when data arrives after we were initialized
+	cxa_stateMachine_setEventDriven(&mppIn->stateMachine, cxa_ioStream_signalsReadable(mppIn->super.ioStream));
+
+	// drain as much as we can (within our budget) in a single update
+	size_t numBytesRemaining = CXA_PROTOCOLPARSER_MQTT_MAXNUM_RX_BYTES_PER_UPDATE;
+	while( numBytesRemaining > 0 )
 	{
-		bool doFlagsMatch = false;
-		switch( cxa_mqtt_message_rxBytes_getType(rxByte) )
+		cxa_ioStream_readStatus_t readStat;
+		switch( cxa_stateMachine_getCurrentState(&mppIn->stateMachine) )
 		{
-			case CXA_MQTT_MSGTYPE_CONNECT:
-			case CXA_MQTT_MSGTYPE_CONNACK:
-			case CXA_MQTT_MSGTYPE_PINGREQ:
-			case CXA_MQTT_MSGTYPE_PINGRESP:
-			case CXA_MQTT_MSGTYPE_SUBACK:
-				// make sure the flags match
-				doFlagsMatch = (rxByte & 0x0F) == 0;
+			case RX_STATE_WAIT_FIXEDHEADER_1:
+				readStat = rxFixedHeader1(mppIn, &numBytesRemaining);
 				break;
 
-			case CXA_MQTT_MSGTYPE_SUBSCRIBE:
-				// make sure the flags match
-				doFlagsMatch = (rxByte & 0x0F) == 0x02;
+			case RX_STATE_WAIT_REMAINING_LEN:
+				readStat = rxRemainingLen(mppIn, &numBytesRemaining);
 				break;
 
-			case CXA_MQTT_MSGTYPE_PUBLISH:
-				// flags don't matter for this one (can be anything)
-				doFlagsMatch = true;
+			case RX_STATE_WAIT_DATABYTES:
+				readStat = rxDataBytes(mppIn, &numBytesRemaining);
 				break;
 
+			case RX_STATE_PROCESS_PACKET:
+				// packet was just delivered...start on the next one
+				cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
+				continue;
+
 			default:
-				cxa_logger_warn(&mppIn->super.logger, "unknown header byte: 0x%02X", rxByte);
+				// someone else moved us (idle, error, etc)
 				return;
 		}
 
-		// if we made it here, we at least know what kind of packet this is...
-		if( doFlagsMatch )
+		if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
 		{
-			// clear our buffer and add the first byte
-			cxa_fixedByteBuffer_clear(mppIn->super.currBuffer);
+			cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_ERROR);
+			return;
+		}
+		else if( readStat == CXA_IOSTREAM_READSTAT_NODATA ) break;
+	}
 
-			if( cxa_fixedByteBuffer_append_uint8(mppIn->super.currBuffer, rxByte) )
-			{
-				// start our reception timeout timeDiff
-				cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
+	// used our whole budget...there may be more data waiting
+	if( numBytesRemaining == 0 ) cxa_runLoop_instance_signalMoreWork(mppIn->stateMachine.runLoop);
 
-				cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_REMAINING_LEN);
-				return;
-			}
-			else cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
-		} else cxa_logger_warn(&mppIn->super.logger, ERR_MALFORMED_HEADER);
+	// check to see if we've had a reception timeout (only matters mid-packet)
+	rxState_t currState = cxa_stateMachine_getCurrentState(&mppIn->stateMachine);
+	if( (currState != RX_STATE_WAIT_REMAINING_LEN) && (currState != RX_STATE_WAIT_DATABYTES) )
+	{
+		cxa_timer_stop(&mppIn->timer_receptionTimeout);
+		return;
 	}
-	else if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
+	uint32_t elapsedTime_ms = cxa_timeDiff_getElapsedTime_ms(&mppIn->super.td_timeout);
+	if( elapsedTime_ms >= RECEPTION_TIMEOUT_MS )
 	{
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_ERROR);
+		cxa_timer_stop(&mppIn->timer_receptionTimeout);
+		cxa_protocolParser_notify_receptionTimeout(&mppIn->super);
+		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
 		return;
 	}
+
+	// make sure we get called again once the timeout is due (more data wakes us sooner)
+	if( !cxa_timer_isRunning(&mppIn->timer_receptionTimeout) ) cxa_timer_startOneShot_ms(&mppIn->timer_receptionTimeout, RECEPTION_TIMEOUT_MS - elapsedTime_ms);
 }
 
 
-static void rxStateCb_waitRemainingLen_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxStateCb_processPacket_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn,void *userVarIn)
 {
 	cxa_protocolParser_mqtt_t *mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
 	cxa_assert(mppIn);
 
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(mppIn->super.ioStream, &rxByte);
-	if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+	// make sure our packet is kosher
+	cxa_mqtt_message_t* msg = cxa_mqtt_messageFactory_getMessage_byBuffer(mppIn->super.currBuffer);
+	if( (msg != NULL) && cxa_mqtt_message_validateReceivedBytes(msg) )
 	{
-		// reset our reception timeout timeDiff
-		cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
-
-		// add to our buffer
-		if( !cxa_fixedByteBuffer_append_uint8(mppIn->super.currBuffer, rxByte) )
-		{
-			cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
-			cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-			return;
-		}
-
-		// process our variable length field (or the fraction we currently have)
-		bool isVarLengthComplete;
-		size_t actualLength;
-		if( !cxa_mqtt_message_rxBytes_parseVariableLengthField(mppIn->super.currBuffer, &isVarLengthComplete, &actualLength, NULL) )
-		{
-			cxa_logger_warn(&mppIn->super.logger, ERR_MALFORMED_HEADER);
-			cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-			return;
-		}
+		// we received a message
+		cxa_logger_trace(&mppIn->super.logger, "message received...calling listeners");
 
-		if( isVarLengthComplete )
-		{
-			mppIn->remainingBytesToReceive = actualLength;
-			cxa_logger_trace(&mppIn->super.logger, "waiting for %d bytes", mppIn->remainingBytesToReceive);
-			cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_DATABYTES);
-			return;
-		}
+		cxa_protocolParser_notify_packetReceived(&mppIn->super, mppIn->super.currBuffer);
 	}
-	else if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
+	else
 	{
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_ERROR);
-		return;
+		cxa_logger_debug(&mppIn->super.logger, ERR_MALFORMED_PACKET);
 	}
 
-	// check to see if we've had a reception timeout
-	if( cxa_timeDiff_isElapsed_ms(&mppIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
-	{
-		cxa_protocolParser_notify_receptionTimeout(&mppIn->super);
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-		return;
-	}
+	// no matter what, we'll reset and wait for more data
+	cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
+	return;
 }
 
 
-static void rxStateCb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxState_cb_error_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
 {
-	cxa_protocolParser_mqtt_t *mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
+	cxa_protocolParser_mqtt_t* mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
 	cxa_assert(mppIn);
 
-	// see if we've gotten enough bytes yet...
-	if( mppIn->remainingBytesToReceive == 0 )
-	{
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_PROCESS_PACKET);
-		return;
-	}
+	cxa_protocolParser_notify_ioException(&mppIn->super);
+}
+
+
+static void timerCb_onReceptionTimeout(cxa_timer_t *const timerIn, void* userVarIn)
+{
+	cxa_protocolParser_mqtt_t* mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
+	cxa_assert(mppIn);
 
-	// keep receiving bytes
+	// our receiving state checks the actual timeout
+	cxa_runLoop_instance_signalMoreWork(mppIn->stateMachine.runLoop);
+}
+
+
+static cxa_ioStream_readStatus_t rxFixedHeader1(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn)
+{
 	uint8_t rxByte;
 	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(mppIn->super.ioStream, &rxByte);
-	if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+	if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) return readStat;
+	(*numBytesRemainingIn)--;
+
+	bool doFlagsMatch = false;
+	switch( cxa_mqtt_message_rxBytes_getType(rxByte) )
+	{
+		case CXA_MQTT_MSGTYPE_CONNECT:
+		case CXA_MQTT_MSGTYPE_CONNACK:
+		case CXA_MQTT_MSGTYPE_PINGREQ:
+		case CXA_MQTT_MSGTYPE_PINGRESP:
+		case CXA_MQTT_MSGTYPE_SUBACK:
+			// make sure the flags match
+			doFlagsMatch = (rxByte & 0x0F) == 0;
+			break;
+
+		case CXA_MQTT_MSGTYPE_SUBSCRIBE:
+			// make sure the flags match
+			doFlagsMatch = (rxByte & 0x0F) == 0x02;
+			break;
+
+		case CXA_MQTT_MSGTYPE_PUBLISH:
+			// flags don't matter for this one (can be anything)
+			doFlagsMatch = true;
+			break;
+
+		default:
+			cxa_logger_warn(&mppIn->super.logger, "unknown header byte: 0x%02X", rxByte);
+			return readStat;
+	}
+
+	// if we made it here, we at least know what kind of packet this is...
+	if( doFlagsMatch )
 	{
-		// reset our reception timeout timeDiff
-		cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
+		// clear our buffer and add the first byte
+		cxa_fixedByteBuffer_clear(mppIn->super.currBuffer);
 
-		// add to our buffer
-		if( !cxa_fixedByteBuffer_append_uint8(mppIn->super.currBuffer, rxByte) )
+		if( cxa_fixedByteBuffer_append_uint8(mppIn->super.currBuffer, rxByte) )
 		{
-			cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
-			cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-			return;
+			// start our reception timeout timeDiff
+			cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
+
+			cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_REMAINING_LEN);
 		}
-		mppIn->remainingBytesToReceive--;
+		else cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
+	} else cxa_logger_warn(&mppIn->super.logger, ERR_MALFORMED_HEADER);
+
+	return readStat;
+}
+
+
+static cxa_ioStream_readStatus_t rxRemainingLen(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn)
+{
+	uint8_t rxByte;
+	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(mppIn->super.ioStream, &rxByte);
+	if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) return readStat;
+	(*numBytesRemainingIn)--;
+
+	// reset our reception timeout timeDiff
+	cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
+
+	// add to our buffer
+	if( !cxa_fixedByteBuffer_append_uint8(mppIn->super.currBuffer, rxByte) )
+	{
+		cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
+		cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
+		return readStat;
 	}
-	else if( readStat == CXA_IOSTREAM_READSTAT_ERROR )
+
+	// process our variable length field (or the fraction we currently have)
+	bool isVarLengthComplete;
+	size_t actualLength;
+	if( !cxa_mqtt_message_rxBytes_parseVariableLengthField(mppIn->super.currBuffer, &isVarLengthComplete, &actualLength, NULL) )
 	{
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_ERROR);
-		return;
+		cxa_logger_warn(&mppIn->super.logger, ERR_MALFORMED_HEADER);
+		cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
+		return readStat;
 	}
 
-	// check to see if we've had a reception timeout
-	if( cxa_timeDiff_isElapsed_ms(&mppIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
+	if( isVarLengthComplete )
 	{
-		cxa_protocolParser_notify_receptionTimeout(&mppIn->super);
-		cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-		return;
+		mppIn->remainingBytesToReceive = actualLength;
+		cxa_logger_trace(&mppIn->super.logger, "waiting for %d bytes", mppIn->remainingBytesToReceive);
+		cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_DATABYTES);
 	}
+
+	return readStat;
 }
 
 
-static void rxStateCb_processPacket_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn,void *userVarIn)
+static cxa_ioStream_readStatus_t rxDataBytes(cxa_protocolParser_mqtt_t *const mppIn, size_t *const numBytesRemainingIn)
 {
-	cxa_protocolParser_mqtt_t *mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
-	cxa_assert(mppIn);
-
-	// make sure our packet is kosher
-	cxa_mqtt_message_t* msg = cxa_mqtt_messageFactory_getMessage_byBuffer(mppIn->super.currBuffer);
-	if( (msg != NULL) && cxa_mqtt_message_validateReceivedBytes(msg) )
+	// see if we've gotten enough bytes yet...
+	if( mppIn->remainingBytesToReceive == 0 )
 	{
-		// we received a message
-		cxa_logger_trace(&mppIn->super.logger, "message received...calling listeners");
-
-		cxa_protocolParser_notify_packetReceived(&mppIn->super, mppIn->super.currBuffer);
+		cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_PROCESS_PACKET);
+		return CXA_IOSTREAM_READSTAT_GOTDATA;
 	}
-	else
+
+	// make sure the rest of the packet will actually fit
+	if( mppIn->remainingBytesToReceive > cxa_fixedByteBuffer_getFreeSize_bytes(mppIn->super.currBuffer) )
 	{
-		cxa_logger_debug(&mppIn->super.logger, ERR_MALFORMED_PACKET);
+		cxa_logger_warn(&mppIn->super.logger, ERR_FBB_OVERFLOW);
+		cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
+		return CXA_IOSTREAM_READSTAT_GOTDATA;
 	}
 
-	// no matter what, we'll reset and wait for more data
-	cxa_stateMachine_transition(&mppIn->stateMachine, RX_STATE_WAIT_FIXEDHEADER_1);
-	return;
-}
+	// reserve space for a run of bytes (size was checked above) and
+	// receive directly into our buffer
+	size_t numBytesToRead = CXA_MIN(mppIn->remainingBytesToReceive, *numBytesRemainingIn);
+	uint8_t* rxBytes = (uint8_t*)cxa_fixedByteBuffer_append_emptyBytes(mppIn->super.currBuffer, numBytesToRead);
+	cxa_assert(rxBytes);
+	size_t numBytesRead = 0;
+	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readBytes(mppIn->super.ioStream, rxBytes, numBytesToRead, &numBytesRead);
 
+	// give back whatever we didn't receive
+	size_t bufferSize_bytes = cxa_fixedByteBuffer_getSize_bytes(mppIn->super.currBuffer);
+	cxa_fixedByteBuffer_remove(mppIn->super.currBuffer, bufferSize_bytes - (numBytesToRead - numBytesRead), numBytesToRead - numBytesRead);
+	if( readStat != CXA_IOSTREAM_READSTAT_GOTDATA ) return readStat;
+	*numBytesRemainingIn -= numBytesRead;
 
-static void rxState_cb_error_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
-{
-	cxa_protocolParser_mqtt_t* mppIn = (cxa_protocolParser_mqtt_t*)userVarIn;
-	cxa_assert(mppIn);
+	// reset our reception timeout timeDiff
+	cxa_timeDiff_setStartTime_now(&mppIn->super.td_timeout);
 
-	cxa_protocolParser_notify_ioException(&mppIn->super);
+	mppIn->remainingBytesToReceive -= numBytesRead;
+
+	if( mppIn->remainingBytesToReceive == 0 ) cxa_stateMachine_transitionNow(&mppIn->stateMachine, RX_STATE_PROCESS_PACKET);
+
+	return readStat;
 }
@@ -58,12 +58,23 @@ static bool addNodePathToTopic(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_messa
 
 // ******** global function implementations ********
 void cxa_mqtt_rpc_node_vinit(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_node_t *const parentNodeIn, const char *nameFmtIn, va_list varArgsIn)
+{
+	cxa_mqtt_rpc_node_vinit_withRunLoop(nodeIn, parentNodeIn,
+										(parentNodeIn != NULL) ? parentNodeIn->runLoop : cxa_runLoop_getDefault(),
+										nameFmtIn, varArgsIn);
+}
+
+
+void cxa_mqtt_rpc_node_vinit_withRunLoop(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_node_t *const parentNodeIn, cxa_runLoop_t *const rlIn,
+										 const char *nameFmtIn, va_list varArgsIn)
 {
 	cxa_assert(nodeIn);
+	cxa_assert(rlIn);
 	cxa_assert(nameFmtIn);
 
 	// save our references and set some defaults
 	nodeIn->parentNode = parentNodeIn;
+	nodeIn->runLoop = rlIn;
 	nodeIn->scm_handleMessage_upstream = scm_handleMessage_upstream;
 	nodeIn->scm_handleMessage_downstream = scm_handleMessage_downstream;
 
@@ -83,7 +94,7 @@ void cxa_mqtt_rpc_node_vinit(cxa_mqtt_rpc_node_t *const nodeIn, cxa_mqtt_rpc_nod
 	if( nodeIn->parentNode != NULL ) cxa_assert( cxa_array_append(&nodeIn->parentNode->subNodes, (void*)&nodeIn) );
 
 	// register for run loop execution
-	cxa_runLoop_addEntry(cb_onRunLoopUpdate, (void*)nodeIn);
+	cxa_runLoop_instance_addEntry(nodeIn->runLoop, cb_onRunLoopUpdate, (void*)nodeIn);
 }
 
 
@@ -63,7 +63,7 @@ void cxa_mqtt_rpc_node_root_init(cxa_mqtt_rpc_node_root_t *const nodeIn, cxa_mqt
 	// initialize our super class
 	va_list varArgs;
 	va_start(varArgs, nameFmtIn);
-	cxa_mqtt_rpc_node_vinit(&nodeIn->super, NULL, nameFmtIn, varArgs);
+	cxa_mqtt_rpc_node_vinit_withRunLoop(&nodeIn->super, NULL, cxa_mqtt_client_getRunLoop(clientIn), nameFmtIn, varArgs);
 	va_end(varArgs);
 
 	// setup our subclass methods / overrides
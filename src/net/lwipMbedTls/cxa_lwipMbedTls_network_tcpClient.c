@@ -65,8 +65,14 @@ static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStat
 static void stateCb_connected_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void* userVarIn);
 static void stateCb_connectFail_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 
+static cxa_ioStream_readStatus_t readPlaintext(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut);
+static cxa_ioStream_readStatus_t refillRxBuffer(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn);
+
 static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t cb_ioStream_readBytes(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
+static bool cb_ioStream_writeVector(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn);
+static bool writePlaintext(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn, uint8_t *const buffIn, size_t numBytesIn);
 
 
 // ********  local variable declarations *********
@@ -85,6 +91,8 @@ void cxa_lwipMbedTls_network_tcpClient_init(cxa_lwipMbedTls_network_tcpClient_t
 	netClientIn->targetHostName[0] = 0;
 	netClientIn->targetPortNum[0] = 0;
 	netClientIn->useClientCert = false;
+	netClientIn->tls.rxBuffer_startIndex = 0;
+	netClientIn->tls.rxBuffer_endIndex = 0;
 
 	cxa_stateMachine_init(&netClientIn->stateMachine, "tcpClient");
 	cxa_stateMachine_addState(&netClientIn->stateMachine, STATE_IDLE, "idle", NULL, NULL, NULL, (void*)netClientIn);
@@ -313,8 +321,14 @@ static void stateCb_connected_enter(cxa_stateMachine_t *const smIn, int prevStat
 		return;
 	}
 
+	// start with an empty plaintext buffer
+	netClientIn->tls.rxBuffer_startIndex = 0;
+	netClientIn->tls.rxBuffer_endIndex = 0;
+
 	// bind our ioStream
 	cxa_ioStream_bind(&netClientIn->super.ioStream, cb_ioStream_readByte, cb_ioStream_writeBytes, (void*)netClientIn);
+	cxa_ioStream_bind_readBytes(&netClientIn->super.ioStream, cb_ioStream_readBytes);
+	cxa_ioStream_bind_writeVector(&netClientIn->super.ioStream, cb_ioStream_writeVector);
 
 	// notify our listeners
 	cxa_array_iterate(&netClientIn->super.listeners, currListener, cxa_network_tcpClient_listenerEntry_t)
@@ -330,8 +344,10 @@ static void stateCb_connected_leave(cxa_stateMachine_t *const smIn, int nextStat
 	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
 
-	// reset our ssl context
+	// reset our ssl context (and discard any undelivered plaintext)
 	mbedtls_ssl_session_reset(&netClientIn->tls.sslContext);
+	netClientIn->tls.rxBuffer_startIndex = 0;
+	netClientIn->tls.rxBuffer_endIndex = 0;
 
 	// notify our listeners
 	cxa_array_iterate(&netClientIn->super.listeners, currListener, cxa_network_tcpClient_listenerEntry_t)
@@ -358,20 +374,101 @@ static void stateCb_connectFail_enter(cxa_stateMachine_t *const smIn, int prevSt
 }
 
 
-static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+static cxa_ioStream_readStatus_t readPlaintext(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut)
 {
-	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
 	cxa_assert(netClientIn);
+	cxa_assert(numBytesReadOut);
+
+	*numBytesReadOut = 0;
 
-	int tmpRet = mbedtls_ssl_read(&netClientIn->tls.sslContext, byteOut, 1);
+	int tmpRet = mbedtls_ssl_read(&netClientIn->tls.sslContext, buffOut, maxLen_bytesIn);
 	if( (tmpRet < 0) && (tmpRet != MBEDTLS_ERR_SSL_WANT_READ) )
 	{
 		cxa_logger_warn(&netClientIn->super.logger, "error during read: %d", tmpRet);
 		cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
 		return CXA_IOSTREAM_READSTAT_ERROR;
 	}
+	if( tmpRet <= 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	*numBytesReadOut = (size_t)tmpRet;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static cxa_ioStream_readStatus_t refillRxBuffer(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn)
+{
+	cxa_assert(netClientIn);
+
+	netClientIn->tls.rxBuffer_startIndex = 0;
+	netClientIn->tls.rxBuffer_endIndex = 0;
+
+	// mbedtls_ssl_read returns at most one record per call...keep going
+	// while already-decrypted data remains and we have room for it
+	do
+	{
+		size_t numBytesRead = 0;
+		cxa_ioStream_readStatus_t retVal = readPlaintext(netClientIn,
+														 &netClientIn->tls.rxBuffer[netClientIn->tls.rxBuffer_endIndex],
+														 sizeof(netClientIn->tls.rxBuffer) - netClientIn->tls.rxBuffer_endIndex,
+														 &numBytesRead);
+		if( retVal == CXA_IOSTREAM_READSTAT_ERROR ) return retVal;
+		if( retVal == CXA_IOSTREAM_READSTAT_NODATA ) break;
+
+		netClientIn->tls.rxBuffer_endIndex += numBytesRead;
+	} while( (netClientIn->tls.rxBuffer_endIndex < sizeof(netClientIn->tls.rxBuffer)) &&
+			 (mbedtls_ssl_get_bytes_avail(&netClientIn->tls.sslContext) > 0) );
+
+	return (netClientIn->tls.rxBuffer_endIndex > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
+static cxa_ioStream_readStatus_t cb_ioStream_readByte(uint8_t *const byteOut, void *const userVarIn)
+{
+	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	if( netClientIn->tls.rxBuffer_startIndex == netClientIn->tls.rxBuffer_endIndex )
+	{
+		cxa_ioStream_readStatus_t retVal = refillRxBuffer(netClientIn);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) return retVal;
+	}
+
+	if( byteOut != NULL ) *byteOut = netClientIn->tls.rxBuffer[netClientIn->tls.rxBuffer_startIndex];
+	netClientIn->tls.rxBuffer_startIndex++;
 
-	return (tmpRet > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
+}
+
+
+static cxa_ioStream_readStatus_t cb_ioStream_readBytes(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+	cxa_assert(numBytesReadOut);
+
+	*numBytesReadOut = 0;
+	if( maxLen_bytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	if( netClientIn->tls.rxBuffer_startIndex == netClientIn->tls.rxBuffer_endIndex )
+	{
+		// large reads can be decrypted directly into the caller's buffer
+		if( (buffOut != NULL) && (maxLen_bytesIn >= sizeof(netClientIn->tls.rxBuffer)) )
+		{
+			return readPlaintext(netClientIn, buffOut, maxLen_bytesIn, numBytesReadOut);
+		}
+
+		cxa_ioStream_readStatus_t retVal = refillRxBuffer(netClientIn);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) return retVal;
+	}
+
+	size_t numBytesToCopy = netClientIn->tls.rxBuffer_endIndex - netClientIn->tls.rxBuffer_startIndex;
+	if( numBytesToCopy > maxLen_bytesIn ) numBytesToCopy = maxLen_bytesIn;
+
+	if( buffOut != NULL ) memcpy(buffOut, &netClientIn->tls.rxBuffer[netClientIn->tls.rxBuffer_startIndex], numBytesToCopy);
+	netClientIn->tls.rxBuffer_startIndex += numBytesToCopy;
+
+	*numBytesReadOut = numBytesToCopy;
+	return CXA_IOSTREAM_READSTAT_GOTDATA;
 }
 
 
@@ -387,15 +484,60 @@ static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 	// make sure we are connected
 	if( !cxa_network_tcpClient_isConnected(&netClientIn->super) ) return false;
 
+	return writePlaintext(netClientIn, buffIn, bufferSize_bytesIn);
+}
+
+
+static bool cb_ioStream_writeVector(cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn, void *const userVarIn)
+{
+	cxa_lwipMbedTls_network_tcpClient_t* netClientIn = (cxa_lwipMbedTls_network_tcpClient_t*)userVarIn;
+	cxa_assert(netClientIn);
+
+	// make sure we are connected
+	if( !cxa_network_tcpClient_isConnected(&netClientIn->super) ) return false;
+
+	// gather into our tx buffer so the whole message goes out in as few records as possible
+	size_t txBufferLen_bytes = 0;
+	for( size_t i = 0; i < numVectorsIn; i++ )
+	{
+		uint8_t* currBuff = (uint8_t*)vectorsIn[i].buff;
+		size_t numBytesRemaining = vectorsIn[i].size_bytes;
+		while( numBytesRemaining > 0 )
+		{
+			// flush when full
+			if( txBufferLen_bytes == sizeof(netClientIn->tls.txBuffer) )
+			{
+				if( !writePlaintext(netClientIn, netClientIn->tls.txBuffer, txBufferLen_bytes) ) return false;
+				txBufferLen_bytes = 0;
+			}
+
+			size_t numBytesToCopy = sizeof(netClientIn->tls.txBuffer) - txBufferLen_bytes;
+			if( numBytesToCopy > numBytesRemaining ) numBytesToCopy = numBytesRemaining;
+
+			memcpy(&netClientIn->tls.txBuffer[txBufferLen_bytes], currBuff, numBytesToCopy);
+			txBufferLen_bytes += numBytesToCopy;
+			currBuff += numBytesToCopy;
+			numBytesRemaining -= numBytesToCopy;
+		}
+	}
+
+	return (txBufferLen_bytes > 0) ? writePlaintext(netClientIn, netClientIn->tls.txBuffer, txBufferLen_bytes) : true;
+}
+
+
+static bool writePlaintext(cxa_lwipMbedTls_network_tcpClient_t *const netClientIn, uint8_t *const buffIn, size_t numBytesIn)
+{
+	cxa_assert(netClientIn);
+
 	int tmpRet;
 	unsigned char* buf = buffIn;
 	do
 	{
-		tmpRet = mbedtls_ssl_write(&netClientIn->tls.sslContext, (const unsigned char*)buf, bufferSize_bytesIn);
+		tmpRet = mbedtls_ssl_write(&netClientIn->tls.sslContext, (const unsigned char*)buf, numBytesIn);
 		if( tmpRet > 0 )
 		{
 			buf += tmpRet;
-			bufferSize_bytesIn -= tmpRet;
+			numBytesIn -= tmpRet;
 		}
 		else if( (tmpRet != MBEDTLS_ERR_SSL_WANT_WRITE) && (tmpRet != MBEDTLS_ERR_SSL_WANT_READ) )
 		{
@@ -403,7 +545,7 @@ static bool cb_ioStream_writeBytes(void* buffIn, size_t bufferSize_bytesIn, void
 			cxa_stateMachine_transition(&netClientIn->stateMachine, STATE_IDLE);
 			return false;
 		}
-	} while( bufferSize_bytesIn > 0 );
+	} while( numBytesIn > 0 );
 
 	return true;
 }
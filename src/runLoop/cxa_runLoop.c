@@ -23,134 +23,735 @@
 
 // ******** includes ********
 #include <cxa_assert.h>
-#include <cxa_timeDiff.h>
+#include <cxa_criticalSection.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_TRACE
 #include <cxa_logger_implementation.h>
 #include <cxa_config.h>
 
+#ifdef CXA_RUNLOOP_TICKLESS_IDLE_ENABLE
+#include <cxa_idle.h>
+#endif
+
+#if defined(CXA_RUNLOOP_PROFILER_ENABLE) && defined(CXA_CONSOLE_ENABLE)
+#include <string.h>
+#include <cxa_console.h>
+#endif
+
 // ******** local macro definitions ********
 #ifndef CXA_RUNLOOP_INFOPRINT_PERIOD_MS
-	#define CXARUNLOOP_INFOPRINT_PERIOD_MS				10000
+	#define CXA_RUNLOOP_INFOPRINT_PERIOD_MS				0
 #endif
 
 #define CXA_RUNLOOP_INFOPRINT_AVGNUMITERS				100
 
-#ifndef CXA_RUN_LOOP_MAXNUM_ENTRIES
-	#define CXA_RUN_LOOP_MAXNUM_ENTRIES					8
+// weight of each new sample in the average background entry run time (1/N)
+#define BACKGROUND_AVGRUNTIME_WEIGHT					8
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	#if (CXA_RUNLOOP_POST_QUEUE_SIZE == 0) || ((CXA_RUNLOOP_POST_QUEUE_SIZE & (CXA_RUNLOOP_POST_QUEUE_SIZE - 1)) != 0)
+		#error "CXA_RUNLOOP_POST_QUEUE_SIZE must be a power of 2"
+	#endif
 #endif
 
 
 // ******** local type definitions ********
-typedef struct
-{
-	cxa_runLoop_cb_update_t cb;
-	void *userVar;
-}cxa_runLoop_entry_t;
-
 
-static cxa_array_t cbs;
-static cxa_runLoop_entry_t cbs_raw[CXA_RUN_LOOP_MAXNUM_ENTRIES];
 
-static cxa_logger_t logger;
-static cxa_timeDiff_t td_printInfo;
-
-#if CXA_RUNLOOP_INFOPRINT_PERIOD_MS > 0
-static uint32_t averageIterPeriod_us = 0;
+// ******** local function prototypes ********
+static void initDefault(void);
+static void addEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn, bool isEventDrivenIn);
+static void removeEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, bool matchUserVarIn, void *const userVarIn);
+static void removeClearedEntries(cxa_runLoop_t *const rlIn);
+static void callEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_entry_t *const entryIn);
+static void callEntriesWithPriority(cxa_runLoop_t *const rlIn, cxa_runLoop_priority_t priorityIn);
+static void callBackgroundEntries(cxa_runLoop_t *const rlIn);
+
+#ifdef CXA_RUNLOOP_TICKLESS_IDLE_ENABLE
+static void idle(cxa_runLoop_t *const rlIn);
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void wakeCb_idle(void* userVarIn);
+#endif
 #endif
 
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void callPostedEntries(cxa_runLoop_t *const rlIn);
+#endif
 
-// ******** local function prototypes ********
-static void cxa_runLoop_init(void);
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void resetProfile(cxa_runLoop_entry_t *const entryIn);
+static void recordSample(cxa_runLoop_entry_t *const entryIn, uint32_t time_usIn);
+#ifdef CXA_CONSOLE_ENABLE
+static void consoleCb_profile(cxa_ioStream_t *const ioStreamIn, void* userVarIn, int argc, char* argv[]);
+#endif
+#endif
 
 
 // ********  local variable declarations *********
 static bool isInit = false;
+static cxa_runLoop_t defaultRunLoop;
+
+static bool isLoggerInit = false;
+static cxa_logger_t logger;
 
 
 // ******** global function implementations ********
+void cxa_runLoop_init(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	cxa_array_initStd(&rlIn->entries, rlIn->entries_raw);
+	rlIn->backgroundBudget_us = CXA_RUNLOOP_BACKGROUND_BUDGET_US;
+	rlIn->nextBackgroundIndex = 0;
+	rlIn->isIterating = false;
+	rlIn->hasClearedEntries = false;
+	rlIn->hasMoreWork = true;
+	cxa_timerWheel_init(&rlIn->timerWheel);
+	cxa_timeDiff_init(&rlIn->td_printInfo);
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	for( size_t i = 0; i < CXA_RUNLOOP_POST_QUEUE_SIZE; i++ )
+	{
+		atomic_init(&rlIn->postQueue[i].sequence, i);
+	}
+	atomic_init(&rlIn->postQueue_enqueueIndex, 0);
+	rlIn->postQueue_dequeueIndex = 0;
+	rlIn->wakeUserVar = NULL;
+#ifdef CXA_RUNLOOP_TICKLESS_IDLE_ENABLE
+	// posted work should wake us from idle
+	atomic_init(&rlIn->cb_wake, wakeCb_idle);
+#else
+	atomic_init(&rlIn->cb_wake, NULL);
+#endif
+#endif
+	rlIn->averageIterPeriod_us = 0;
+
+	// shared by all run loops (which may be initialized from different threads)
+	cxa_criticalSection_enter();
+	if( !isLoggerInit )
+	{
+		cxa_logger_init(&logger, "runLoop");
+		isLoggerInit = true;
+	}
+	cxa_criticalSection_exit();
+}
+
+
+cxa_runLoop_t* cxa_runLoop_getDefault(void)
+{
+	if( !isInit ) initDefault();
+
+	return &defaultRunLoop;
+}
+
+
 void cxa_runLoop_addEntry(cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
 {
-	if( !isInit ) cxa_runLoop_init();
+	cxa_runLoop_instance_addEntry(cxa_runLoop_getDefault(), cbIn, userVarIn);
+}
 
-	// create our new entry
-	cxa_runLoop_entry_t newEntry = {.cb=cbIn, .userVar=userVarIn};
-	cxa_assert_msg(cxa_array_append(&cbs, &newEntry), "increase CXA_RUNLOOP_MAX_NUM_ENTRIES");
+
+void cxa_runLoop_addEntry_withPriority(cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn)
+{
+	cxa_runLoop_instance_addEntry_withPriority(cxa_runLoop_getDefault(), cbIn, userVarIn, priorityIn);
+}
+
+
+void cxa_runLoop_addEntry_eventDriven(cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	cxa_runLoop_instance_addEntry_eventDriven(cxa_runLoop_getDefault(), cbIn, userVarIn);
 }
 
 
 void cxa_runLoop_removeEntry(cxa_runLoop_cb_update_t cbIn)
 {
-	if( !isInit ) cxa_runLoop_init();
+	cxa_runLoop_instance_removeEntry(cxa_runLoop_getDefault(), cbIn);
+}
 
-	// can't use cxa_array_iterate because we need an index
-	for( size_t i = 0; i < cxa_array_getSize_elems(&cbs); i++ )
-	{
-		cxa_runLoop_entry_t* currEntry = (cxa_runLoop_entry_t*)cxa_array_get(&cbs, i);
-		if( currEntry == NULL ) continue;
 
-		if( currEntry->cb == cbIn )
-		{
-			cxa_array_remove_atIndex(&cbs, i);
-			return;
-		}
-	}
+void cxa_runLoop_removeEntry_withUserVar(cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	cxa_runLoop_instance_removeEntry_withUserVar(cxa_runLoop_getDefault(), cbIn, userVarIn);
 }
 
 
 void cxa_runLoop_clearAllEntries(void)
 {
-	isInit = false;
-	cxa_runLoop_init();
+	cxa_runLoop_instance_clearAllEntries(cxa_runLoop_getDefault());
+}
+
+
+size_t cxa_runLoop_getNumEntries(void)
+{
+	return cxa_runLoop_instance_getNumEntries(cxa_runLoop_getDefault());
+}
+
+
+void cxa_runLoop_setBackgroundBudget_us(uint32_t budget_usIn)
+{
+	cxa_runLoop_instance_setBackgroundBudget_us(cxa_runLoop_getDefault(), budget_usIn);
 }
 
 
 void cxa_runLoop_iterate(void)
 {
-	if( !isInit ) cxa_runLoop_init();
+	cxa_runLoop_instance_iterate(cxa_runLoop_getDefault());
+}
+
+
+void cxa_runLoop_execute(void)
+{
+	cxa_runLoop_instance_execute(cxa_runLoop_getDefault());
+}
+
+
+void cxa_runLoop_instance_addEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	cxa_runLoop_instance_addEntry_withPriority(rlIn, cbIn, userVarIn, CXA_RUNLOOP_PRIORITY_NORMAL);
+}
+
+
+void cxa_runLoop_instance_addEntry_withPriority(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn)
+{
+	cxa_assert(rlIn);
+
+	addEntry(rlIn, cbIn, userVarIn, priorityIn, false);
+}
+
+
+void cxa_runLoop_instance_addEntry_eventDriven(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	cxa_assert(rlIn);
+
+	addEntry(rlIn, cbIn, userVarIn, CXA_RUNLOOP_PRIORITY_NORMAL, true);
+}
+
+
+void cxa_runLoop_instance_removeEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn)
+{
+	cxa_assert(rlIn);
+
+	removeEntry(rlIn, cbIn, false, NULL);
+}
+
+
+void cxa_runLoop_instance_removeEntry_withUserVar(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	cxa_assert(rlIn);
+
+	removeEntry(rlIn, cbIn, true, userVarIn);
+}
+
+
+void cxa_runLoop_instance_clearAllEntries(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	cxa_array_clear(&rlIn->entries);
+	rlIn->nextBackgroundIndex = 0;
+	rlIn->hasClearedEntries = false;
+}
+
+
+size_t cxa_runLoop_instance_getNumEntries(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	return cxa_array_getSize_elems(&rlIn->entries);
+}
+
+
+void cxa_runLoop_instance_setBackgroundBudget_us(cxa_runLoop_t *const rlIn, uint32_t budget_usIn)
+{
+	cxa_assert(rlIn);
+
+	rlIn->backgroundBudget_us = budget_usIn;
+}
+
+
+void cxa_runLoop_signalMoreWork(void)
+{
+	cxa_runLoop_instance_signalMoreWork(cxa_runLoop_getDefault());
+}
+
+
+void cxa_runLoop_instance_signalMoreWork(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	rlIn->hasMoreWork = true;
+}
+
+
+bool cxa_runLoop_instance_hasMoreWork(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	return rlIn->hasMoreWork;
+}
+
+
+bool cxa_runLoop_instance_canIdle(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	if( rlIn->hasMoreWork ) return false;
+
+	// polled entries need to be called continuously
+	cxa_array_iterate(&rlIn->entries, currEntry, cxa_runLoop_entry_t)
+	{
+		if( (currEntry->cb != NULL) && !currEntry->isEventDriven ) return false;
+	}
+
+	return true;
+}
+
+
+void cxa_runLoop_instance_iterate(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
 
 #if CXA_RUNLOOP_INFOPRINT_PERIOD_MS > 0
 	uint32_t iter_startTime_us = cxa_timeBase_getCount_us();
 #endif
 
-	cxa_array_iterate(&cbs, currEntry, cxa_runLoop_entry_t)
-	{
-		if( currEntry->cb != NULL) currEntry->cb(currEntry->userVar);
-	}
+	// everything is called this iteration...entries will signal if they need more
+	rlIn->hasMoreWork = false;
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+	// handle work from other threads first
+	callPostedEntries(rlIn);
+#endif
+
+	// expire any timers that are due
+	cxa_timerWheel_update(&rlIn->timerWheel);
+
+	bool wasIterating = rlIn->isIterating;
+	rlIn->isIterating = true;
+
+	callEntriesWithPriority(rlIn, CXA_RUNLOOP_PRIORITY_HIGH);
+	callEntriesWithPriority(rlIn, CXA_RUNLOOP_PRIORITY_NORMAL);
+	callBackgroundEntries(rlIn);
+
+	rlIn->isIterating = wasIterating;
+	if( !rlIn->isIterating && rlIn->hasClearedEntries ) removeClearedEntries(rlIn);
 
 #if CXA_RUNLOOP_INFOPRINT_PERIOD_MS > 0
 	uint32_t iter_time_us = cxa_timeBase_getCount_us() - iter_startTime_us;
-	averageIterPeriod_us -= averageIterPeriod_us / CXA_RUNLOOP_INFOPRINT_AVGNUMITERS;
-	averageIterPeriod_us += iter_time_us;
+	rlIn->averageIterPeriod_us -= rlIn->averageIterPeriod_us / CXA_RUNLOOP_INFOPRINT_AVGNUMITERS;
+	rlIn->averageIterPeriod_us += iter_time_us;
 
-	if( cxa_timeDiff_isElapsed_recurring_ms(&td_printInfo, CXA_RUNLOOP_INFOPRINT_PERIOD_MS) )
+	if( cxa_timeDiff_isElapsed_recurring_ms(&rlIn->td_printInfo, CXA_RUNLOOP_INFOPRINT_PERIOD_MS) )
 	{
-		cxa_logger_debug(&logger, "iteration  curr: %d ms  avg: %d ms", iter_time_us / 1000, averageIterPeriod_us / 1000);
+		cxa_logger_debug(&logger, "%p iteration  curr: %d ms  avg: %d ms", rlIn, iter_time_us / 1000, rlIn->averageIterPeriod_us / 1000);
 	}
 #endif
 }
 
 
-void cxa_runLoop_execute(void)
+void cxa_runLoop_instance_execute(cxa_runLoop_t *const rlIn)
 {
-	if( !isInit ) cxa_runLoop_init();
+	cxa_assert(rlIn);
 
 	while(1)
 	{
-		cxa_runLoop_iterate();
+		cxa_runLoop_instance_iterate(rlIn);
+#ifdef CXA_RUNLOOP_TICKLESS_IDLE_ENABLE
+		idle(rlIn);
+#endif
 	}
 }
 
 
+cxa_timerWheel_t* cxa_runLoop_instance_getTimerWheel(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	return &rlIn->timerWheel;
+}
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+bool cxa_runLoop_post(cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	return cxa_runLoop_instance_post(cxa_runLoop_getDefault(), cbIn, userVarIn);
+}
+
+
+bool cxa_runLoop_instance_post(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn)
+{
+	// may be called from a signal handler...so no asserts
+	if( (rlIn == NULL) || (cbIn == NULL) ) return false;
+
+	// claim a free entry (multiple producers may be racing us for it)
+	cxa_runLoop_postEntry_t* entry;
+	size_t index = atomic_load_explicit(&rlIn->postQueue_enqueueIndex, memory_order_relaxed);
+	while(1)
+	{
+		entry = &rlIn->postQueue[index % CXA_RUNLOOP_POST_QUEUE_SIZE];
+		size_t sequence = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)index;
+
+		if( diff == 0 )
+		{
+			// entry is free...try to claim it (updates index on failure)
+			if( atomic_compare_exchange_weak_explicit(&rlIn->postQueue_enqueueIndex, &index, index+1,
+													  memory_order_relaxed, memory_order_relaxed) ) break;
+		}
+		else if( diff < 0 )
+		{
+			// entry hasn't been consumed yet...queue is full
+			return false;
+		}
+		else
+		{
+			// another producer claimed this entry
+			index = atomic_load_explicit(&rlIn->postQueue_enqueueIndex, memory_order_relaxed);
+		}
+	}
+
+	// fill in the entry, then publish it to the run loop
+	entry->cb = cbIn;
+	entry->userVar = userVarIn;
+	atomic_store_explicit(&entry->sequence, index+1, memory_order_release);
+
+	// wakeUserVar is published with cb_wake
+	cxa_runLoop_cb_wake_t cb_wake = atomic_load_explicit(&rlIn->cb_wake, memory_order_acquire);
+	if( cb_wake != NULL ) cb_wake(rlIn->wakeUserVar);
+
+	return true;
+}
+
+
+void cxa_runLoop_instance_setWakeCb(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_wake_t cbIn, void *const userVarIn)
+{
+	cxa_assert(rlIn);
+
+	// clear the callback while we change the user variable
+	atomic_store_explicit(&rlIn->cb_wake, NULL, memory_order_release);
+	rlIn->wakeUserVar = userVarIn;
+	atomic_store_explicit(&rlIn->cb_wake, cbIn, memory_order_release);
+}
+#endif
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+bool cxa_runLoop_profiler_getProfile(size_t indexIn, cxa_runLoop_profile_t *const profileOut)
+{
+	return cxa_runLoop_instance_profiler_getProfile(cxa_runLoop_getDefault(), indexIn, profileOut);
+}
+
+
+void cxa_runLoop_profiler_reset(void)
+{
+	cxa_runLoop_instance_profiler_reset(cxa_runLoop_getDefault());
+}
+
+
+void cxa_runLoop_profiler_writeReport(cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_runLoop_instance_profiler_writeReport(cxa_runLoop_getDefault(), ioStreamIn);
+}
+
+
+bool cxa_runLoop_instance_profiler_getProfile(cxa_runLoop_t *const rlIn, size_t indexIn, cxa_runLoop_profile_t *const profileOut)
+{
+	cxa_assert(rlIn);
+	cxa_assert(profileOut);
+
+	cxa_runLoop_entry_t* targetEntry = (cxa_runLoop_entry_t*)cxa_array_get(&rlIn->entries, indexIn);
+	if( targetEntry == NULL ) return false;
+
+	*profileOut = targetEntry->profile;
+	return true;
+}
+
+
+void cxa_runLoop_instance_profiler_reset(cxa_runLoop_t *const rlIn)
+{
+	cxa_assert(rlIn);
+
+	cxa_array_iterate(&rlIn->entries, currEntry, cxa_runLoop_entry_t)
+	{
+		resetProfile(currEntry);
+	}
+}
+
+
+void cxa_runLoop_instance_profiler_writeReport(cxa_runLoop_t *const rlIn, cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(rlIn);
+	cxa_assert(ioStreamIn);
+
+	// field-by-field since formatted strings are limited in length
+	cxa_ioStream_writeString(ioStreamIn, "callback           userVar                 calls     avg_us     max_us" CXA_LINE_ENDING);
+	cxa_array_iterate(&rlIn->entries, currEntry, cxa_runLoop_entry_t)
+	{
+		cxa_runLoop_profile_t* currProfile = &currEntry->profile;
+		uint32_t avgTime_us = (currProfile->numCalls > 0) ? (uint32_t)(currProfile->cumulativeTime_us / currProfile->numCalls) : 0;
+
+		cxa_ioStream_writeFormattedString(ioStreamIn, "%-18p ", (void*)currProfile->cb);
+		cxa_ioStream_writeFormattedString(ioStreamIn, "%-18p ", currProfile->userVar);
+		cxa_ioStream_writeFormattedString(ioStreamIn, "%10lu ", (unsigned long)currProfile->numCalls);
+		cxa_ioStream_writeFormattedString(ioStreamIn, "%10lu ", (unsigned long)avgTime_us);
+		cxa_ioStream_writeFormattedString(ioStreamIn, "%10lu", (unsigned long)currProfile->maxTime_us);
+		cxa_ioStream_writeString(ioStreamIn, CXA_LINE_ENDING);
+
+		// histogram (only the non-empty buckets)
+		cxa_ioStream_writeString(ioStreamIn, "   ");
+		for( size_t i = 0; i < CXA_RUNLOOP_PROFILER_NUM_BUCKETS; i++ )
+		{
+			if( currProfile->histogram[i] == 0 ) continue;
+			cxa_ioStream_writeFormattedString(ioStreamIn, " %s%lu:%lu",
+											  (i == (CXA_RUNLOOP_PROFILER_NUM_BUCKETS - 1)) ? ">=" : "<",
+											  (unsigned long)((i == (CXA_RUNLOOP_PROFILER_NUM_BUCKETS - 1)) ? (1UL << (i - 1)) : (1UL << i)),
+											  (unsigned long)currProfile->histogram[i]);
+		}
+		cxa_ioStream_writeString(ioStreamIn, CXA_LINE_ENDING);
+	}
+}
+
+
+#ifdef CXA_CONSOLE_ENABLE
+void cxa_runLoop_profiler_addConsoleCommand(void)
+{
+	cxa_console_addCommand("runLoop.profile", consoleCb_profile, NULL);
+}
+#endif
+#endif
+
+
 // ******** local function implementations ********
-static void cxa_runLoop_init(void)
+static void initDefault(void)
 {
 	if( isInit ) return;
 
-	cxa_array_initStd(&cbs, cbs_raw);
-	cxa_logger_init(&logger, "runLoop");
-	cxa_timeDiff_init(&td_printInfo);
+	cxa_runLoop_init(&defaultRunLoop);
 
 	isInit = true;
 }
 
+
+static void addEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, void *const userVarIn, cxa_runLoop_priority_t priorityIn, bool isEventDrivenIn)
+{
+	// create our new entry
+	cxa_runLoop_entry_t newEntry = {.cb=cbIn, .userVar=userVarIn, .priority=priorityIn, .avgRunTime_us=0, .isEventDriven=isEventDrivenIn};
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	resetProfile(&newEntry);
+#endif
+	cxa_assert_msg(cxa_array_append(&rlIn->entries, &newEntry), "increase CXA_RUN_LOOP_MAX_NUM_ENTRIES");
+
+	// make sure the new entry gets called
+	rlIn->hasMoreWork = true;
+}
+
+
+static void removeEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_cb_update_t cbIn, bool matchUserVarIn, void *const userVarIn)
+{
+	// can't use cxa_array_iterate because we need an index
+	for( size_t i = 0; i < cxa_array_getSize_elems(&rlIn->entries); i++ )
+	{
+		cxa_runLoop_entry_t* currEntry = (cxa_runLoop_entry_t*)cxa_array_get(&rlIn->entries, i);
+		if( (currEntry == NULL) || (currEntry->cb != cbIn) ) continue;
+		if( matchUserVarIn && (currEntry->userVar != userVarIn) ) continue;
+
+		if( rlIn->isIterating )
+		{
+			// don't shift the entries out from under the current iteration
+			currEntry->cb = NULL;
+			rlIn->hasClearedEntries = true;
+		}
+		else cxa_array_remove_atIndex(&rlIn->entries, i);
+		return;
+	}
+}
+
+
+static void removeClearedEntries(cxa_runLoop_t *const rlIn)
+{
+	for( size_t i = 0; i < cxa_array_getSize_elems(&rlIn->entries); )
+	{
+		cxa_runLoop_entry_t* currEntry = (cxa_runLoop_entry_t*)cxa_array_get(&rlIn->entries, i);
+		if( (currEntry != NULL) && (currEntry->cb == NULL) )
+		{
+			cxa_array_remove_atIndex(&rlIn->entries, i);
+			if( rlIn->nextBackgroundIndex > i ) rlIn->nextBackgroundIndex--;
+		}
+		else i++;
+	}
+	rlIn->hasClearedEntries = false;
+}
+
+
+static void callEntry(cxa_runLoop_t *const rlIn, cxa_runLoop_entry_t *const entryIn)
+{
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+	size_t numEntries = cxa_array_getSize_elems(&rlIn->entries);
+	uint32_t startTime_us = cxa_timeBase_getCount_us();
+
+	entryIn->cb(entryIn->userVar);
+
+	// don't record if the callback removed entries (entryIn may have moved)
+	if( numEntries == cxa_array_getSize_elems(&rlIn->entries) ) recordSample(entryIn, cxa_timeBase_getCount_us() - startTime_us);
+#else
+	entryIn->cb(entryIn->userVar);
+#endif
+}
+
+
+static void callEntriesWithPriority(cxa_runLoop_t *const rlIn, cxa_runLoop_priority_t priorityIn)
+{
+	cxa_array_iterate(&rlIn->entries, currEntry, cxa_runLoop_entry_t)
+	{
+		if( (currEntry->priority == priorityIn) && (currEntry->cb != NULL) ) callEntry(rlIn, currEntry);
+	}
+}
+
+
+static void callBackgroundEntries(cxa_runLoop_t *const rlIn)
+{
+	uint32_t startTime_us = cxa_timeBase_getCount_us();
+	size_t numEntries = cxa_array_getSize_elems(&rlIn->entries);
+	bool hasCalledEntry = false;
+
+	// round-robin, starting where we left off last iteration
+	for( size_t i = 0; i < numEntries; i++ )
+	{
+		size_t currIndex = (rlIn->nextBackgroundIndex + i) % numEntries;
+		cxa_runLoop_entry_t* currEntry = (cxa_runLoop_entry_t*)cxa_array_get(&rlIn->entries, currIndex);
+		if( (currEntry == NULL) || (currEntry->priority != CXA_RUNLOOP_PRIORITY_BACKGROUND) || (currEntry->cb == NULL) ) continue;
+
+		// stop once this entry is likely to exceed our budget
+		// (but always make _some_ progress)
+		if( hasCalledEntry && (rlIn->backgroundBudget_us > 0) )
+		{
+			uint32_t elapsed_us = cxa_timeBase_getCount_us() - startTime_us;
+			if( (elapsed_us >= rlIn->backgroundBudget_us) || (currEntry->avgRunTime_us > (rlIn->backgroundBudget_us - elapsed_us)) )
+			{
+				// deferred entries still need to be called
+				rlIn->nextBackgroundIndex = currIndex;
+				rlIn->hasMoreWork = true;
+				return;
+			}
+		}
+
+		uint32_t entryStartTime_us = cxa_timeBase_getCount_us();
+		callEntry(rlIn, currEntry);
+		uint32_t entryRunTime_us = cxa_timeBase_getCount_us() - entryStartTime_us;
+		hasCalledEntry = true;
+
+		// the callback may have removed entries
+		if( numEntries != cxa_array_getSize_elems(&rlIn->entries) )
+		{
+			rlIn->nextBackgroundIndex = 0;
+			return;
+		}
+		currEntry->avgRunTime_us -= currEntry->avgRunTime_us / BACKGROUND_AVGRUNTIME_WEIGHT;
+		currEntry->avgRunTime_us += entryRunTime_us / BACKGROUND_AVGRUNTIME_WEIGHT;
+
+		// high priority entries shouldn't have to wait for us
+		callEntriesWithPriority(rlIn, CXA_RUNLOOP_PRIORITY_HIGH);
+		if( numEntries != cxa_array_getSize_elems(&rlIn->entries) )
+		{
+			rlIn->nextBackgroundIndex = 0;
+			return;
+		}
+	}
+
+	// called everything...start from the beginning next time
+	rlIn->nextBackgroundIndex = 0;
+}
+
+
+#ifdef CXA_RUNLOOP_TICKLESS_IDLE_ENABLE
+static void idle(cxa_runLoop_t *const rlIn)
+{
+	if( !cxa_runLoop_instance_canIdle(rlIn) ) return;
+
+	// sleep until our next timer is due (posted work and interrupts wake us early)
+	uint32_t sleepTime_ms = CXA_IDLE_FOREVER;
+	if( cxa_timerWheel_getTimeUntilNextDeadline_ms(&rlIn->timerWheel, &sleepTime_ms) && (sleepTime_ms == 0) ) return;
+
+	cxa_idle_sleep_ms(sleepTime_ms);
+}
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void wakeCb_idle(void* userVarIn)
+{
+	cxa_idle_wake();
+}
+#endif
+#endif
+
+
+#ifdef CXA_RUNLOOP_POST_ENABLE
+static void callPostedEntries(cxa_runLoop_t *const rlIn)
+{
+	// only what was queued when we started (callbacks may post again)
+	for( size_t i = 0; i < CXA_RUNLOOP_POST_QUEUE_SIZE; i++ )
+	{
+		cxa_runLoop_postEntry_t* entry = &rlIn->postQueue[rlIn->postQueue_dequeueIndex % CXA_RUNLOOP_POST_QUEUE_SIZE];
+
+		// stop at the first entry that hasn't been published yet
+		if( atomic_load_explicit(&entry->sequence, memory_order_acquire) != (rlIn->postQueue_dequeueIndex + 1) ) return;
+
+		cxa_runLoop_cb_update_t cb = entry->cb;
+		void* userVar = entry->userVar;
+
+		// free the entry for the next lap around the queue
+		atomic_store_explicit(&entry->sequence, rlIn->postQueue_dequeueIndex + CXA_RUNLOOP_POST_QUEUE_SIZE, memory_order_release);
+		rlIn->postQueue_dequeueIndex++;
+
+		cb(userVar);
+	}
+}
+#endif
+
+
+#ifdef CXA_RUNLOOP_PROFILER_ENABLE
+static void resetProfile(cxa_runLoop_entry_t *const entryIn)
+{
+	entryIn->profile.cb = entryIn->cb;
+	entryIn->profile.userVar = entryIn->userVar;
+	entryIn->profile.numCalls = 0;
+	entryIn->profile.cumulativeTime_us = 0;
+	entryIn->profile.maxTime_us = 0;
+	for( size_t i = 0; i < CXA_RUNLOOP_PROFILER_NUM_BUCKETS; i++ ) entryIn->profile.histogram[i] = 0;
+}
+
+
+static void recordSample(cxa_runLoop_entry_t *const entryIn, uint32_t time_usIn)
+{
+	cxa_runLoop_profile_t* profile = &entryIn->profile;
+
+	profile->numCalls++;
+	profile->cumulativeTime_us += time_usIn;
+	if( time_usIn > profile->maxTime_us ) profile->maxTime_us = time_usIn;
+
+	// bucket is the number of significant bits in the time
+	size_t bucketIndex = 0;
+	while( (time_usIn > 0) && (bucketIndex < (CXA_RUNLOOP_PROFILER_NUM_BUCKETS - 1)) )
+	{
+		time_usIn >>= 1;
+		bucketIndex++;
+	}
+	profile->histogram[bucketIndex]++;
+}
+
+
+#ifdef CXA_CONSOLE_ENABLE
+static void consoleCb_profile(cxa_ioStream_t *const ioStreamIn, void* userVarIn, int argc, char* argv[])
+{
+	// argv[0] is the command itself
+	if( (argc > 1) && (strcmp(argv[1], "reset") == 0) )
+	{
+		cxa_runLoop_profiler_reset();
+		cxa_ioStream_writeLine(ioStreamIn, "profile reset");
+		return;
+	}
+
+	cxa_runLoop_profiler_writeReport(ioStreamIn);
+}
+#endif
+#endif
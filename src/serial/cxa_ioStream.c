@@ -69,17 +69,47 @@ void cxa_ioStream_bind(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readByt
 
 	// save our references
 	ioStreamIn->readCb = readCbIn;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = writeCbIn;
+	ioStreamIn->writeVectorCb = NULL;
+	ioStreamIn->signalsReadable = false;
 	ioStreamIn->userVar = userVarIn;
 }
 
 
+void cxa_ioStream_bind_readBytes(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_readBytes_t readBytesCbIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->readBytesCb = readBytesCbIn;
+}
+
+
+void cxa_ioStream_bind_writeVector(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_cb_writeVector_t writeVectorCbIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->writeVectorCb = writeVectorCbIn;
+}
+
+
+void cxa_ioStream_bind_signalsReadable(cxa_ioStream_t *const ioStreamIn, bool signalsReadableIn)
+{
+	cxa_assert(ioStreamIn);
+
+	ioStreamIn->signalsReadable = signalsReadableIn;
+}
+
+
 void cxa_ioStream_unbind(cxa_ioStream_t *const ioStreamIn)
 {
 	cxa_assert(ioStreamIn);
 
 	ioStreamIn->readCb = NULL;
+	ioStreamIn->readBytesCb = NULL;
 	ioStreamIn->writeCb = NULL;
+	ioStreamIn->writeVectorCb = NULL;
+	ioStreamIn->signalsReadable = false;
 	ioStreamIn->userVar = NULL;
 }
 
@@ -92,6 +122,14 @@ bool cxa_ioStream_isBound(cxa_ioStream_t *const ioStreamIn)
 }
 
 
+bool cxa_ioStream_signalsReadable(cxa_ioStream_t *const ioStreamIn)
+{
+	cxa_assert(ioStreamIn);
+
+	return cxa_ioStream_isBound(ioStreamIn) && ioStreamIn->signalsReadable;
+}
+
+
 cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn, uint8_t *const byteOut)
 {
 	cxa_assert(ioStreamIn);
@@ -103,6 +141,41 @@ cxa_ioStream_readStatus_t cxa_ioStream_readByte(cxa_ioStream_t *const ioStreamIn
 }
 
 
+cxa_ioStream_readStatus_t cxa_ioStream_readBytes(cxa_ioStream_t *const ioStreamIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut)
+{
+	cxa_assert(ioStreamIn);
+	cxa_assert(buffOut);
+
+	if( numBytesReadOut != NULL ) *numBytesReadOut = 0;
+
+	// make sure we're bound
+	if( !cxa_ioStream_isBound(ioStreamIn) ) return CXA_IOSTREAM_READSTAT_ERROR;
+	if( maxLen_bytesIn == 0 ) return CXA_IOSTREAM_READSTAT_NODATA;
+
+	// use the native bulk read if we have one
+	size_t numBytesRead = 0;
+	cxa_ioStream_readStatus_t retVal = CXA_IOSTREAM_READSTAT_NODATA;
+	if( ioStreamIn->readBytesCb != NULL )
+	{
+		retVal = ioStreamIn->readBytesCb(buffOut, maxLen_bytesIn, &numBytesRead, ioStreamIn->userVar);
+		if( numBytesReadOut != NULL ) *numBytesReadOut = numBytesRead;
+		return retVal;
+	}
+
+	// no native bulk read...fall back to single-byte reads
+	while( numBytesRead < maxLen_bytesIn )
+	{
+		retVal = ioStreamIn->readCb(&buffOut[numBytesRead], ioStreamIn->userVar);
+		if( retVal != CXA_IOSTREAM_READSTAT_GOTDATA ) break;
+		numBytesRead++;
+	}
+	if( numBytesReadOut != NULL ) *numBytesReadOut = numBytesRead;
+
+	// data takes precedence (any error will recur on the next read)
+	return (numBytesRead > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : retVal;
+}
+
+
 bool cxa_ioStream_waitForCharSequence_withTimeout(cxa_ioStream_t *const ioStreamIn, const char* targetSeqIn, uint32_t timeout_msIn)
 {
 	cxa_assert(ioStreamIn);
@@ -167,6 +240,28 @@ bool cxa_ioStream_writeBytes(cxa_ioStream_t *const ioStreamIn, void* buffIn, siz
 }
 
 
+bool cxa_ioStream_writeVector(cxa_ioStream_t *const ioStreamIn, cxa_ioStream_vector_t *const vectorsIn, size_t numVectorsIn)
+{
+	cxa_assert(ioStreamIn);
+	if( numVectorsIn > 0 ) cxa_assert(vectorsIn);
+
+	// make sure we're bound
+	if( !cxa_ioStream_isBound(ioStreamIn) ) return false;
+
+	// use the native gather-write if we have one
+	if( ioStreamIn->writeVectorCb != NULL ) return ioStreamIn->writeVectorCb(vectorsIn, numVectorsIn, ioStreamIn->userVar);
+
+	// no native gather-write...fall back to sequential writes
+	for( size_t i = 0; i < numVectorsIn; i++ )
+	{
+		if( vectorsIn[i].size_bytes == 0 ) continue;
+		if( !ioStreamIn->writeCb(vectorsIn[i].buff, vectorsIn[i].size_bytes, ioStreamIn->userVar) ) return false;
+	}
+
+	return true;
+}
+
+
 bool cxa_ioStream_writeFixedByteBuffer(cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const fbbIn)
 {
 	cxa_assert(ioStreamIn);
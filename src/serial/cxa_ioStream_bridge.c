@@ -28,6 +28,7 @@
 
 
 // ******** local function prototypes ********
+static void transfer(cxa_ioStream_bridge_t *const bridgeIn, cxa_ioStream_t *const srcIn, cxa_ioStream_t *const destIn, cxa_ioStream_bridge_stagingBuffer_t *const stagingIn);
 static void cb_onRunLoopUpdate(void* userVarIn);
 
 
@@ -46,25 +47,61 @@ void cxa_ioStream_bridge_init(cxa_ioStream_bridge_t *const bridgeIn,
 	// save our references
 	bridgeIn->stream1 = stream1In;
 	bridgeIn->stream2 = stream2In;
+	bridgeIn->maxNumBytesPerUpdate = CXA_IOSTREAM_BRIDGE_DEFAULT_MAXNUM_BYTES_PER_UPDATE;
+	bridgeIn->staging_1to2.numBytesPending = 0;
+	bridgeIn->staging_2to1.numBytesPending = 0;
 
 	// register for run loop execution
 	cxa_runLoop_addEntry(cb_onRunLoopUpdate, (void*)bridgeIn);
 }
 
 
+void cxa_ioStream_bridge_setMaxBytesPerUpdate(cxa_ioStream_bridge_t *const bridgeIn, size_t maxNumBytesIn)
+{
+	cxa_assert(bridgeIn);
+	cxa_assert(maxNumBytesIn > 0);
+
+	bridgeIn->maxNumBytesPerUpdate = maxNumBytesIn;
+}
+
+
 // ******** local function implementations ********
-static void cb_onRunLoopUpdate(void* userVarIn)
+static void transfer(cxa_ioStream_bridge_t *const bridgeIn, cxa_ioStream_t *const srcIn, cxa_ioStream_t *const destIn, cxa_ioStream_bridge_stagingBuffer_t *const stagingIn)
 {
-	cxa_ioStream_bridge_t* bridgeIn = (cxa_ioStream_bridge_t*)userVarIn;
+	cxa_assert(bridgeIn);
+	cxa_assert(srcIn);
+	cxa_assert(destIn);
+	cxa_assert(stagingIn);
 
-	uint8_t rxByte;
-	if( cxa_ioStream_readByte(bridgeIn->stream1, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
+	size_t numBytesRemaining = bridgeIn->maxNumBytesPerUpdate;
+	while( true )
 	{
-		cxa_ioStream_writeByte(bridgeIn->stream2, rxByte);
+		// anything left over from a previous (refused) write goes first...a
+		// refused write takes none of the bytes, so we resend all of them
+		if( stagingIn->numBytesPending > 0 )
+		{
+			// destination can't take it right now...stop reading from the source
+			if( !cxa_ioStream_writeBytes(destIn, stagingIn->buffer, stagingIn->numBytesPending) ) return;
+			stagingIn->numBytesPending = 0;
+		}
+
+		if( numBytesRemaining == 0 ) return;
+
+		size_t numBytesToRead = (numBytesRemaining < sizeof(stagingIn->buffer)) ? numBytesRemaining : sizeof(stagingIn->buffer);
+		size_t numBytesRead = 0;
+		if( cxa_ioStream_readBytes(srcIn, stagingIn->buffer, numBytesToRead, &numBytesRead) != CXA_IOSTREAM_READSTAT_GOTDATA ) return;
+
+		stagingIn->numBytesPending = numBytesRead;
+		numBytesRemaining -= numBytesRead;
 	}
+}
 
-	if( cxa_ioStream_readByte(bridgeIn->stream2, &rxByte) == CXA_IOSTREAM_READSTAT_GOTDATA )
-	{
-		cxa_ioStream_writeByte(bridgeIn->stream1, rxByte);
-	}
+
+static void cb_onRunLoopUpdate(void* userVarIn)
+{
+	cxa_ioStream_bridge_t* bridgeIn = (cxa_ioStream_bridge_t*)userVarIn;
+	cxa_assert(bridgeIn);
+
+	transfer(bridgeIn, bridgeIn->stream1, bridgeIn->stream2, &bridgeIn->staging_1to2);
+	transfer(bridgeIn, bridgeIn->stream2, bridgeIn->stream1, &bridgeIn->staging_2to1);
 }
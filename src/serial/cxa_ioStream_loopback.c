@@ -36,6 +36,7 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
@@ -53,6 +54,7 @@ void cxa_ioStream_loopback_init(cxa_ioStream_loopback_t *const ioStreamIn)
 	// initialize our super class
 	cxa_ioStream_init(&ioStreamIn->super);
 	cxa_ioStream_bind(&ioStreamIn->super, read_cb, write_cb, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->super, readBytes_cb);
 }
 
 
@@ -66,16 +68,26 @@ static cxa_ioStream_readStatus_t read_cb(uint8_t *const byteOut, void *const use
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_assert(numBytesReadOut);
+	cxa_ioStream_loopback_t* ioStreamIn = (cxa_ioStream_loopback_t*)userVarIn;
+
+	size_t numBytesRead = cxa_fixedFifo_bulkDequeue_copy(&ioStreamIn->fifo, buffOut, maxLen_bytesIn);
+
+	*numBytesReadOut = numBytesRead;
+	return (numBytesRead > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
+}
+
+
 static bool write_cb(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_loopback_t* ioStreamIn = (cxa_ioStream_loopback_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
-
-	return true;
+	// all or nothing (so a refused write can be retried without duplicating bytes)
+	if( cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo) < bufferSize_bytesIn ) return false;
+	return cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo, buffIn, bufferSize_bytesIn);
 }
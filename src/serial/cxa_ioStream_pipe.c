@@ -36,8 +36,11 @@
 
 // ******** local function prototypes ********
 static cxa_ioStream_readStatus_t read_cb_ep1(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
 static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 static cxa_ioStream_readStatus_t read_cb_ep2(uint8_t *const byteOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn);
+static cxa_ioStream_readStatus_t readBytes_fromFifo(cxa_fixedFifo_t *const fifoIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut);
 static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn);
 
 
@@ -52,10 +55,12 @@ void cxa_ioStream_pipe_init(cxa_ioStream_pipe_t *const ioStreamIn)
 	// initialize our ioStreams
 	cxa_ioStream_init(&ioStreamIn->endPoint1);
 	cxa_ioStream_bind(&ioStreamIn->endPoint1, read_cb_ep1, write_cb_ep1, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->endPoint1, readBytes_cb_ep1);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep1Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep1Read_raw);
 
 	cxa_ioStream_init(&ioStreamIn->endPoint2);
 	cxa_ioStream_bind(&ioStreamIn->endPoint2, read_cb_ep2, write_cb_ep2, (void*)ioStreamIn);
+	cxa_ioStream_bind_readBytes(&ioStreamIn->endPoint2, readBytes_cb_ep2);
 	cxa_fixedFifo_initStd(&ioStreamIn->fifo_ep2Read, CXA_FF_ON_FULL_DROP, ioStreamIn->fifo_ep2Read_raw);
 }
 
@@ -83,18 +88,24 @@ static cxa_ioStream_readStatus_t read_cb_ep1(uint8_t *const byteOut, void *const
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb_ep1(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
+
+	return readBytes_fromFifo(&ioStreamIn->fifo_ep1Read, buffOut, maxLen_bytesIn, numBytesReadOut);
+}
+
+
 static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep2Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
-
-	return true;
+	// all or nothing (so a refused write can be retried without duplicating bytes)
+	if( cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep2Read) < bufferSize_bytesIn ) return false;
+	return cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep2Read, buffIn, bufferSize_bytesIn);
 }
 
 
@@ -107,16 +118,34 @@ static cxa_ioStream_readStatus_t read_cb_ep2(uint8_t *const byteOut, void *const
 }
 
 
+static cxa_ioStream_readStatus_t readBytes_cb_ep2(uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut, void *const userVarIn)
+{
+	cxa_assert(userVarIn);
+	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
+
+	return readBytes_fromFifo(&ioStreamIn->fifo_ep2Read, buffOut, maxLen_bytesIn, numBytesReadOut);
+}
+
+
 static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const userVarIn)
 {
 	cxa_assert(userVarIn);
 	cxa_ioStream_pipe_t* ioStreamIn = (cxa_ioStream_pipe_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep1Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	// all or nothing (so a refused write can be retried without duplicating bytes)
+	if( cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep1Read) < bufferSize_bytesIn ) return false;
+	return cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep1Read, buffIn, bufferSize_bytesIn);
+}
+
+
+static cxa_ioStream_readStatus_t readBytes_fromFifo(cxa_fixedFifo_t *const fifoIn, uint8_t *const buffOut, size_t maxLen_bytesIn, size_t *const numBytesReadOut)
+{
+	cxa_assert(fifoIn);
+	cxa_assert(numBytesReadOut);
+
+	size_t numBytesRead = cxa_fixedFifo_bulkDequeue_copy(fifoIn, buffOut, maxLen_bytesIn);
 
-	return true;
+	*numBytesReadOut = numBytesRead;
+	return (numBytesRead > 0) ? CXA_IOSTREAM_READSTAT_GOTDATA : CXA_IOSTREAM_READSTAT_NODATA;
 }
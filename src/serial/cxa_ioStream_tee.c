@@ -102,11 +102,12 @@ static bool write_cb_ep1(void* buffIn, size_t bufferSize_bytesIn, void *const us
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep2Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep3Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	// all or nothing (so a refused write can be retried without duplicating bytes on either endpoint)
+	if( (cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep2Read) < bufferSize_bytesIn) ||
+		(cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep3Read) < bufferSize_bytesIn) ) return false;
+
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep2Read, buffIn, bufferSize_bytesIn) ) return false;
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep3Read, buffIn, bufferSize_bytesIn) ) return false;
 
 	return true;
 }
@@ -127,11 +128,12 @@ static bool write_cb_ep2(void* buffIn, size_t bufferSize_bytesIn, void *const us
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep1Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep3Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	// all or nothing (so a refused write can be retried without duplicating bytes on either endpoint)
+	if( (cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep1Read) < bufferSize_bytesIn) ||
+		(cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep3Read) < bufferSize_bytesIn) ) return false;
+
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep1Read, buffIn, bufferSize_bytesIn) ) return false;
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep3Read, buffIn, bufferSize_bytesIn) ) return false;
 
 	return true;
 }
@@ -152,11 +154,12 @@ static bool write_cb_ep3(void* buffIn, size_t bufferSize_bytesIn, void *const us
 	cxa_ioStream_tee_t* ioStreamIn = (cxa_ioStream_tee_t*)userVarIn;
 	if( buffIn == NULL ) return false;
 
-	for( size_t i = 0; i < bufferSize_bytesIn; i++ )
-	{
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep1Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-		if( !cxa_fixedFifo_queue(&ioStreamIn->fifo_ep2Read, (void*)&(((uint8_t*)buffIn)[i])) ) return false;
-	}
+	// all or nothing (so a refused write can be retried without duplicating bytes on either endpoint)
+	if( (cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep1Read) < bufferSize_bytesIn) ||
+		(cxa_fixedFifo_getFreeSize_elems(&ioStreamIn->fifo_ep2Read) < bufferSize_bytesIn) ) return false;
+
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep1Read, buffIn, bufferSize_bytesIn) ) return false;
+	if( !cxa_fixedFifo_bulkQueue(&ioStreamIn->fifo_ep2Read, buffIn, bufferSize_bytesIn) ) return false;
 
 	return true;
 }
@@ -17,15 +17,17 @@
 
 
 // ******** includes ********
+#include <string.h>
 #include <cxa_assert.h>
+#include <cxa_numberUtils.h>
 
 #define CXA_LOG_LEVEL		CXA_LOG_LEVEL_INFO
 #include <cxa_logger_implementation.h>
 
 
 // ******** local macro definitions ********
-#define MAX_NUM_RX_BYTES_PER_UPDATE		16
 #define RECEPTION_TIMEOUT_MS			5000
+#define HEADER_SIZE_BYTES				4
 
 
 // ******** local type definitions ********
@@ -51,36 +53,52 @@ static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuf
 static void rxState_cb_idle_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarIn);
 static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateIdIn, void *userVarIn);
-static void rxState_cb_wait0x80_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxState_cb_wait0x81_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxState_cb_waitLen_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxState_cb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void *userVarIn);
-static void rxState_cb_processPacket_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void rxState_cb_receiving_state(cxa_stateMachine_t *const smIn, void *userVarIn);
+static void rxState_cb_processPacket_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 static void rxState_cb_error_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn);
 
+static void timerCb_onReceptionTimeout(cxa_timer_t *const timerIn, void* userVarIn);
+
+static size_t parseBytes(cxa_protocolParser_cleProto_t *const clePpIn, uint8_t *const bytesIn, size_t numBytesIn);
+
 
 // ********  local variable declarations *********
 
 
 // ******** global function implementations ********
 void cxa_protocolParser_cleProto_init(cxa_protocolParser_cleProto_t *const clePpIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn)
+{
+	cxa_protocolParser_cleProto_init_withRunLoop(clePpIn, ioStreamIn, buffIn, cxa_runLoop_getDefault());
+}
+
+
+void cxa_protocolParser_cleProto_init_withRunLoop(cxa_protocolParser_cleProto_t *const clePpIn, cxa_ioStream_t *const ioStreamIn, cxa_fixedByteBuffer_t *const buffIn,
+												  cxa_runLoop_t *const rlIn)
 {
 	cxa_assert(clePpIn);
 	cxa_assert(ioStreamIn);
 
+	// nothing read yet
+	clePpIn->rxChunk_startIndex = 0;
+	clePpIn->rxChunk_endIndex = 0;
+
 	// initialize our super class
 	cxa_protocolParser_init(&clePpIn->super, ioStreamIn, buffIn, scm_isInErrorState, scm_canSetBuffer, scm_gotoIdle, scm_writeBytes);
 
 	// setup our state machine
-	cxa_stateMachine_init(&clePpIn->stateMachine, "protocolParser");
+	cxa_stateMachine_init_withRunLoop(&clePpIn->stateMachine, "protocolParser", rlIn);
 	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_IDLE, "idle", rxState_cb_idle_enter, rxState_cb_idle_state, rxState_cb_idle_leave, (void*)clePpIn);
-	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_0x80, "wait_0x80", NULL, rxState_cb_wait0x80_state, NULL, (void*)clePpIn);
-	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_0x81, "wait_0x81", NULL, rxState_cb_wait0x81_state, NULL, (void*)clePpIn);
-	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_LEN, "wait_len", NULL, rxState_cb_waitLen_state, NULL, (void*)clePpIn);
-	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES, "wait_dataBytes", NULL, rxState_cb_waitDataBytes_state, NULL, (void*)clePpIn);
-	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", NULL, rxState_cb_processPacket_state, NULL, (void*)clePpIn);
+	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_0x80, "wait_0x80", NULL, rxState_cb_receiving_state, NULL, (void*)clePpIn);
+	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_0x81, "wait_0x81", NULL, rxState_cb_receiving_state, NULL, (void*)clePpIn);
+	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_LEN, "wait_len", NULL, rxState_cb_receiving_state, NULL, (void*)clePpIn);
+	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES, "wait_dataBytes", NULL, rxState_cb_receiving_state, NULL, (void*)clePpIn);
+	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET, "processPacket", rxState_cb_processPacket_enter, NULL, NULL, (void*)clePpIn);
 	cxa_stateMachine_addState(&clePpIn->stateMachine, RX_STATE_ERROR, "error", rxState_cb_error_enter, NULL, NULL, (void*)clePpIn);
 	cxa_stateMachine_setInitialState(&clePpIn->stateMachine, RX_STATE_IDLE);
+
+	// if our ioStream tells us when data arrives, we only need to wake for reception timeouts
+	cxa_timer_init_withRunLoop(&clePpIn->timer_receptionTimeout, rlIn, timerCb_onReceptionTimeout, (void*)clePpIn);
+	if( cxa_ioStream_signalsReadable(ioStreamIn) ) cxa_stateMachine_setEventDriven(&clePpIn->stateMachine, true);
 }
 
 
@@ -126,21 +144,19 @@ static bool scm_writeBytes(cxa_protocolParser_t *const superIn, cxa_fixedByteBuf
 	// make sure we're in a good state
 	if( clePpIn->super.scm_isInError(&clePpIn->super) || !cxa_ioStream_isBound(clePpIn->super.ioStream) ) return false;
 
-	// write our header
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x80) ) return false;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x81) ) return false;
-
+	// header, data, and footer go out as a single write
 	size_t len = msgSize_bytes + 1;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, ((len & 0x00FF) >> 0)) ) return false;
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, ((len & 0xFF00) >> 8)) ) return false;
+	uint8_t header[HEADER_SIZE_BYTES] = {0x80, 0x81, ((len & 0x00FF) >> 0), ((len & 0xFF00) >> 8)};
+	uint8_t footer = 0x82;
 
-	// write our data
-	if( (fbbIn != NULL) && !cxa_ioStream_writeFixedByteBuffer(clePpIn->super.ioStream, fbbIn) ) return false;
-
-	// write our footer
-	if( !cxa_ioStream_writeByte(clePpIn->super.ioStream, 0x82) ) return false;
+	cxa_ioStream_vector_t vectors[] =
+	{
+		{.buff=header, .size_bytes=sizeof(header)},
+		{.buff=(msgSize_bytes > 0) ? (void*)cxa_fixedByteBuffer_get_pointerToIndex(fbbIn, 0) : NULL, .size_bytes=msgSize_bytes},
+		{.buff=&footer, .size_bytes=sizeof(footer)}
+	};
 
-	return true;
+	return cxa_ioStream_writeVector(clePpIn->super.ioStream, vectors, sizeof(vectors)/sizeof(*vectors));
 }
 
 
@@ -164,6 +180,9 @@ static void rxState_cb_idle_state(cxa_stateMachine_t *const smIn, void *userVarI
 		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 		return;
 	}
+
+	// nothing tells us when we get a buffer...keep checking
+	cxa_runLoop_instance_signalMoreWork(clePpIn->stateMachine.runLoop);
 }
 
 
@@ -176,158 +195,64 @@ static void rxState_cb_idle_leave(cxa_stateMachine_t *const smIn, int nextStateI
 }
 
 
-static void rxState_cb_wait0x80_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxState_cb_receiving_state(cxa_stateMachine_t *const smIn, void *userVarIn)
 {
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
 	cxa_assert(clePpIn);
 
-	uint8_t rxByte;
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
-	{
-		cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
-		if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-		else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
-		{
-			if( rxByte == 0x80 )
-			{
-				// we've gotten our first header byte
-				cxa_fixedByteBuffer_clear(clePpIn->super.currBuffer);
-				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-
-				// start our reception timeout timeDiff
-				cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+	// our ioStream may only start telling us when data arrives after we were initialized
+	cxa_stateMachine_setEventDriven(&clePpIn->stateMachine, cxa_ioStream_signalsReadable(clePpIn->super.ioStream));
 
-				cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x81);
-				return;
-			}
-		}
-	}
-}
-
-
-static void rxState_cb_wait0x81_state(cxa_stateMachine_t *const smIn, void *userVarIn)
-{
-	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
-	cxa_assert(clePpIn);
-
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
-	if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-	else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
+	// read and parse blocks until we run dry or exhaust our budget
+	size_t numBytesRemaining = CXA_PROTOCOLPARSER_CLEPROTO_MAXNUM_RX_BYTES_PER_UPDATE;
+	while( numBytesRemaining > 0 )
 	{
-		// reset our reception timeout timeDiff
-		cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
-
-		if( rxByte == 0x81 )
-		{
-			// we have a valid second header byte
-			cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_LEN);
-			return;
-		}
-		else
+		// anything left from a previous block (see below) is parsed before we read more
+		if( clePpIn->rxChunk_startIndex == clePpIn->rxChunk_endIndex )
 		{
-			// we have an invalid second header byte
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
-			return;
-		}
-	}
-
-	// check to see if we've had a reception timeout
-	if( cxa_timeDiff_isElapsed_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
-	{
-		cxa_protocolParser_notify_receptionTimeout(&clePpIn->super);
-		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
-		return;
-	}
-}
-
-
-static void rxState_cb_waitLen_state(cxa_stateMachine_t *const smIn, void *userVarIn)
-{
-	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
-	cxa_assert(clePpIn);
-
-	uint8_t rxByte;
-	cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
-	if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-	else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
-	{
-		// reset our reception timeout timeDiff
-		cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
+			size_t numBytesRead = 0;
+			cxa_ioStream_readStatus_t readStat = cxa_ioStream_readBytes(clePpIn->super.ioStream, clePpIn->rxChunk, CXA_MIN(sizeof(clePpIn->rxChunk), numBytesRemaining), &numBytesRead);
+			if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
+			else if( readStat == CXA_IOSTREAM_READSTAT_NODATA ) break;
+			numBytesRemaining -= numBytesRead;
+			clePpIn->rxChunk_startIndex = 0;
+			clePpIn->rxChunk_endIndex = numBytesRead;
 
-		// just append the byte
-		cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-		if( cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) == 4 )
-		{
-			// we have all of our length bytes...make sure it's valid
-			uint16_t len_bytes;
-			if( cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, len_bytes) && (len_bytes >= 1) ) cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_DATA_BYTES);
-			return;
+			// reset our reception timeout timeDiff
+			cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
 		}
-	}
 
-	// check to see if we've had a reception timeout
-	if( cxa_timeDiff_isElapsed_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
-	{
-			cxa_protocolParser_notify_receptionTimeout(&clePpIn->super);
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
-			return;
+		// if we didn't parse the whole block, someone else moved us (idle, error, etc)...
+		// keep the rest for when we're receiving again
+		clePpIn->rxChunk_startIndex += parseBytes(clePpIn, &clePpIn->rxChunk[clePpIn->rxChunk_startIndex], clePpIn->rxChunk_endIndex - clePpIn->rxChunk_startIndex);
+		if( clePpIn->rxChunk_startIndex < clePpIn->rxChunk_endIndex ) return;
 	}
-}
-
 
-static void rxState_cb_waitDataBytes_state(cxa_stateMachine_t *const smIn, void *userVarIn)
-{
-	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
-	cxa_assert(clePpIn);
+	// used our whole budget...there may be more data waiting
+	if( numBytesRemaining == 0 ) cxa_runLoop_instance_signalMoreWork(clePpIn->stateMachine.runLoop);
 
-	// get our expected size
-	uint16_t expectedSize_bytes;
-	if( !cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, expectedSize_bytes) )
+	// check to see if we've had a reception timeout (only matters mid-packet)
+	rxState_t currState = (rxState_t)cxa_stateMachine_getCurrentState(&clePpIn->stateMachine);
+	if( currState == RX_STATE_WAIT_0x80 )
 	{
-		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+		cxa_timer_stop(&clePpIn->timer_receptionTimeout);
 		return;
 	}
-
-	// do a limited number of iterations
-	for( uint8_t i = 0; i < MAX_NUM_RX_BYTES_PER_UPDATE; i++ )
+	uint32_t elapsedTime_ms = cxa_timeDiff_getElapsedTime_ms(&clePpIn->super.td_timeout);
+	if( elapsedTime_ms >= RECEPTION_TIMEOUT_MS )
 	{
-		size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) - 4;
-
-		if( currSize_bytes < expectedSize_bytes )
-		{
-			// we have more bytes to receive
-			uint8_t rxByte;
-			cxa_ioStream_readStatus_t readStat = cxa_ioStream_readByte(clePpIn->super.ioStream, &rxByte);
-			if( readStat == CXA_IOSTREAM_READSTAT_ERROR ) { cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_ERROR); return; }
-			else if( readStat == CXA_IOSTREAM_READSTAT_GOTDATA )
-			{
-				// reset our reception timeout timeDiff
-				cxa_timeDiff_setStartTime_now(&clePpIn->super.td_timeout);
-
-				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, rxByte);
-			}
-		}
-		else
-		{
-			// we're done receiving our data bytes
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET);
-			return;
-		}
+		cxa_timer_stop(&clePpIn->timer_receptionTimeout);
+		cxa_protocolParser_notify_receptionTimeout(&clePpIn->super);
+		cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+		return;
 	}
 
-	// check to see if we've had a reception timeout
-	if( cxa_timeDiff_isElapsed_ms(&clePpIn->super.td_timeout, RECEPTION_TIMEOUT_MS) )
-	{
-			cxa_protocolParser_notify_receptionTimeout(&clePpIn->super);
-			cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
-			return;
-	}
+	// make sure we get called again once the timeout is due (more data wakes us sooner)
+	if( !cxa_timer_isRunning(&clePpIn->timer_receptionTimeout) ) cxa_timer_startOneShot_ms(&clePpIn->timer_receptionTimeout, RECEPTION_TIMEOUT_MS - elapsedTime_ms);
 }
 
 
-static void rxState_cb_processPacket_state(cxa_stateMachine_t *const smIn, void *userVarIn)
+static void rxState_cb_processPacket_enter(cxa_stateMachine_t *const smIn, int prevStateIdIn, void *userVarIn)
 {
 	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
 	cxa_assert(clePpIn);
@@ -358,8 +283,8 @@ static void rxState_cb_processPacket_state(cxa_stateMachine_t *const smIn, void
 		cxa_logger_debug(&clePpIn->super.logger, "improperly formatted message received");
 	}
 
-	// no matter what, we'll reset and wait for more data
-	cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+	// no matter what, we'll reset and wait for more data (unless a listener moved us)
+	if( cxa_stateMachine_getCurrentState(&clePpIn->stateMachine) == RX_STATE_PROCESS_PACKET ) cxa_stateMachine_transition(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
 }
 
 
@@ -370,3 +295,111 @@ static void rxState_cb_error_enter(cxa_stateMachine_t *const smIn, int prevState
 
 	cxa_protocolParser_notify_ioException(&clePpIn->super);
 }
+
+
+static void timerCb_onReceptionTimeout(cxa_timer_t *const timerIn, void* userVarIn)
+{
+	cxa_protocolParser_cleProto_t* clePpIn = (cxa_protocolParser_cleProto_t*)userVarIn;
+	cxa_assert(clePpIn);
+
+	// our receiving state checks the actual timeout
+	cxa_runLoop_instance_signalMoreWork(clePpIn->stateMachine.runLoop);
+}
+
+
+static size_t parseBytes(cxa_protocolParser_cleProto_t *const clePpIn, uint8_t *const bytesIn, size_t numBytesIn)
+{
+	cxa_assert(clePpIn);
+
+	size_t currIndex = 0;
+	while( currIndex < numBytesIn )
+	{
+		uint8_t* currBytes = &bytesIn[currIndex];
+		size_t numBytesLeft = numBytesIn - currIndex;
+
+		switch( (rxState_t)cxa_stateMachine_getCurrentState(&clePpIn->stateMachine) )
+		{
+			case RX_STATE_WAIT_0x80:
+			{
+				// scan the whole block for the start of a header
+				uint8_t* headerStart = memchr(currBytes, 0x80, numBytesLeft);
+				if( headerStart == NULL ) return numBytesIn;
+				currIndex += (size_t)(headerStart - currBytes) + 1;
+
+				// we've gotten our first header byte
+				cxa_fixedByteBuffer_clear(clePpIn->super.currBuffer);
+				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, 0x80);
+				cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x81);
+				break;
+			}
+
+			case RX_STATE_WAIT_0x81:
+				if( *currBytes == 0x81 )
+				{
+					// we have a valid second header byte
+					cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, *currBytes);
+					currIndex++;
+					cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_LEN);
+				}
+				else
+				{
+					// invalid second header byte...resync (starting with this byte)
+					cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+				}
+				break;
+
+			case RX_STATE_WAIT_LEN:
+			{
+				cxa_fixedByteBuffer_append_uint8(clePpIn->super.currBuffer, *currBytes);
+				currIndex++;
+				if( cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) == HEADER_SIZE_BYTES )
+				{
+					// we have all of our length bytes...make sure it's valid
+					uint16_t len_bytes;
+					bool isLenValid = cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, len_bytes) && (len_bytes >= 1);
+					cxa_stateMachine_transitionNow(&clePpIn->stateMachine, isLenValid ? RX_STATE_WAIT_DATA_BYTES : RX_STATE_WAIT_0x80);
+				}
+				break;
+			}
+
+			case RX_STATE_WAIT_DATA_BYTES:
+			{
+				// figure out how many of this block's bytes belong to this packet
+				uint16_t expectedSize_bytes;
+				if( !cxa_fixedByteBuffer_get_uint16LE(clePpIn->super.currBuffer, 2, expectedSize_bytes) )
+				{
+					cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+					break;
+				}
+				size_t currSize_bytes = cxa_fixedByteBuffer_getSize_bytes(clePpIn->super.currBuffer) - HEADER_SIZE_BYTES;
+				size_t numBytesToCopy = CXA_MIN(numBytesLeft, (expectedSize_bytes - currSize_bytes));
+
+				// copy the whole run at once
+				if( !cxa_fixedByteBuffer_append(clePpIn->super.currBuffer, currBytes, numBytesToCopy) )
+				{
+					cxa_logger_warn(&clePpIn->super.logger, "packet too large for buffer");
+					cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+					break;
+				}
+				currIndex += numBytesToCopy;
+
+				// deliver the packet if it's complete
+				if( (currSize_bytes + numBytesToCopy) == expectedSize_bytes ) cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_PROCESS_PACKET);
+				break;
+			}
+
+			case RX_STATE_PROCESS_PACKET:
+				// packet was just delivered...start on the next one
+				cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+				break;
+
+			default:
+				return currIndex;
+		}
+	}
+
+	// if the last byte of the block completed a packet, get ready for the next one
+	if( cxa_stateMachine_getCurrentState(&clePpIn->stateMachine) == RX_STATE_PROCESS_PACKET ) cxa_stateMachine_transitionNow(&clePpIn->stateMachine, RX_STATE_WAIT_0x80);
+
+	return currIndex;
+}
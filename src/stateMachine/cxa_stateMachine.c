@@ -38,8 +38,13 @@
 
 // ******** local function prototypes ********
 static void cb_onRunLoopUpdate(void* userVarIn);
+static void addToRunLoop(cxa_stateMachine_t *const smIn);
 
+static void addState(cxa_stateMachine_t *const smIn, cxa_stateMachine_state_t *const newStateIn);
 static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn);
+#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+static void timerCb_onTimedTransition(cxa_timer_t *const timerIn, void* userVarIn);
+#endif
 
 
 // ********  local variable declarations *********
@@ -47,16 +52,26 @@ static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, i
 
 // ******** global function implementations ********
 void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn)
+{
+	cxa_stateMachine_init_withRunLoop(smIn, nameIn, cxa_runLoop_getDefault());
+}
+
+
+void cxa_stateMachine_init_withRunLoop(cxa_stateMachine_t *const smIn, const char* nameIn, cxa_runLoop_t *const rlIn)
 {
 	cxa_assert(smIn);
 	cxa_assert(nameIn);
+	cxa_assert(rlIn);
 	
 	// set some sensible defaults
 	smIn->currState = NULL;
 	smIn->nextState = NULL;
+	smIn->runLoop = rlIn;
+	smIn->isEventDriven = false;
 	
 	// setup our internal state
 	cxa_array_init(&smIn->states, sizeof(*smIn->states_raw), (void*)smIn->states_raw, sizeof(smIn->states_raw));
+	for( size_t i = 0; i < CXA_STATE_MACHINE_MAX_NUM_STATES; i++ ) smIn->states_byId[i] = NULL;
 	
 	// setup our logger if it's enabled
 	#ifdef CXA_STATE_MACHINE_ENABLE_LOGGING
@@ -66,12 +81,28 @@ void cxa_stateMachine_init(cxa_stateMachine_t *const smIn, const char* nameIn)
 	// a timediff was _not_ supplied so we cannot do timed states
 	// even if they are enabled
 	#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-	cxa_timeDiff_init(&smIn->td_timedTransition);
+	cxa_timer_init_withRunLoop(&smIn->timer_timedTransition, smIn->runLoop, timerCb_onTimedTransition, (void*)smIn);
 	smIn->timedStatesEnabled = true;
 	#endif
 
 	// register for run loop execution
-	cxa_runLoop_addEntry(cb_onRunLoopUpdate, (void*)smIn);
+	addToRunLoop(smIn);
+}
+
+
+void cxa_stateMachine_setEventDriven(cxa_stateMachine_t *const smIn, bool isEventDrivenIn)
+{
+	cxa_assert(smIn);
+
+	if( smIn->isEventDriven == isEventDrivenIn ) return;
+	smIn->isEventDriven = isEventDrivenIn;
+
+	// re-register so the run loop knows whether we poll
+	if( smIn->isInRunLoop )
+	{
+		cxa_runLoop_instance_removeEntry_withUserVar(smIn->runLoop, cb_onRunLoopUpdate, (void*)smIn);
+		addToRunLoop(smIn);
+	}
 }
 
 
@@ -89,9 +120,7 @@ void cxa_stateMachine_addState(cxa_stateMachine_t *const smIn, int idIn, const c
 	// create our new state
 	cxa_stateMachine_state_t newState = {.type=CXA_STATE_MACHINE_STATE_TYPE_NORMAL, .stateId=idIn, .stateName=nameIn,
 		.cb_enter=cb_enterIn, .cb_state=cb_stateIn, .cb_leave=cb_leaveIn, .userVar=userVarIn};
-
-	// add the new state to our array of states
-	cxa_assert_msg(cxa_array_append(&smIn->states, &newState), "increase 'CXA_STATE_MACHINE_MAX_NUM_STATES'");
+	addState(smIn, &newState);
 	
 	// if we're currently not in a known state, enter this state (when update is called)
 	if( smIn->currState == NULL ) cxa_stateMachine_transition(smIn, idIn);
@@ -114,9 +143,7 @@ void cxa_stateMachine_addState_timed(cxa_stateMachine_t *const smIn, int idIn, c
 	cxa_stateMachine_state_t newState = {.type=CXA_STATE_MACHINE_STATE_TYPE_TIMED, .stateId=idIn, .stateName=nameIn,
 		.nextStateId=nextStateIdIn, .stateTime_ms=stateTime_msIn,
 		.cb_enter=cb_enterIn, .cb_state=cb_stateIn, .cb_leave=cb_leaveIn, .userVar=userVarIn};
-
-	// add the new state to our array of states
-	cxa_assert(cxa_array_append(&smIn->states, &newState));
+	addState(smIn, &newState);
 
 	// if we're currently not in a known state, enter this state (when update is called)
 	if( smIn->currState == NULL ) cxa_stateMachine_transition(smIn, idIn);	
@@ -144,6 +171,10 @@ void cxa_stateMachine_transition(cxa_stateMachine_t *const smIn, int stateIdIn)
 	
 	// we have a valid new state...mark for transition
 	smIn->nextState = newNextState;
+
+	// make sure we'll actually get updated
+	if( !smIn->isInRunLoop ) addToRunLoop(smIn);
+	cxa_runLoop_instance_signalMoreWork(smIn->runLoop);
 }
 
 
@@ -178,6 +209,9 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		if( smIn->currState != NULL )
 		{
 			prevStateId = smIn->currState->stateId;
+			#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+				cxa_timer_stop(&smIn->timer_timedTransition);
+			#endif
 			if( smIn->currState->cb_leave != NULL ) smIn->currState->cb_leave(smIn, smIn->nextState->stateId, smIn->currState->userVar);
 		}
 				
@@ -193,32 +227,55 @@ static void cb_onRunLoopUpdate(void* userVarIn)
 		if( smIn->currState->cb_enter != NULL ) smIn->currState->cb_enter(smIn, prevStateId, smIn->currState->userVar);
 		
 		#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-			if( smIn->timedStatesEnabled && (smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) ) cxa_timeDiff_setStartTime_now(&smIn->td_timedTransition);
+			if( smIn->timedStatesEnabled && (smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) && (smIn->nextState == NULL) )
+			{
+				cxa_timer_startOneShot_ms(&smIn->timer_timedTransition, smIn->currState->stateTime_ms);
+			}
 		#endif
 	}
 	else
 	{
-		#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
-			// see if our state's time has expired...if so, transition into our next state
-			if(  smIn->timedStatesEnabled &&
-				(smIn->currState->type == CXA_STATE_MACHINE_STATE_TYPE_TIMED) &&
-				 cxa_timeDiff_isElapsed_ms(&smIn->td_timedTransition, smIn->currState->stateTime_ms) )
-			{
-				cxa_stateMachine_transition(smIn, smIn->currState->nextStateId);
-				return;
-			}
-		#endif
-
 		// keep updating our state
 		if( (smIn->currState != NULL) && (smIn->currState->cb_state != NULL) ) smIn->currState->cb_state(smIn, smIn->currState->userVar);
 	}
+
+	// nothing to do until our next transition...stop getting updated
+	// (timed states are expired by our timer, so they don't need updating either)
+	if( smIn->isInRunLoop && (smIn->nextState == NULL) && (smIn->currState != NULL) && (smIn->currState->cb_state == NULL) )
+	{
+		cxa_runLoop_instance_removeEntry_withUserVar(smIn->runLoop, cb_onRunLoopUpdate, (void*)smIn);
+		smIn->isInRunLoop = false;
+	}
+}
+
+
+static void addToRunLoop(cxa_stateMachine_t *const smIn)
+{
+	if( smIn->isEventDriven ) cxa_runLoop_instance_addEntry_eventDriven(smIn->runLoop, cb_onRunLoopUpdate, (void*)smIn);
+	else cxa_runLoop_instance_addEntry(smIn->runLoop, cb_onRunLoopUpdate, (void*)smIn);
+	smIn->isInRunLoop = true;
+}
+
+
+static void addState(cxa_stateMachine_t *const smIn, cxa_stateMachine_state_t *const newStateIn)
+{
+	// add the new state to our array of states
+	cxa_stateMachine_state_t* newState = (cxa_stateMachine_state_t*)cxa_array_append_empty(&smIn->states);
+	cxa_assert_msg(newState, "increase 'CXA_STATE_MACHINE_MAX_NUM_STATES'");
+	*newState = *newStateIn;
+
+	// states are never removed, so pointers into our array remain valid
+	if( (newState->stateId >= 0) && (newState->stateId < CXA_STATE_MACHINE_MAX_NUM_STATES) ) smIn->states_byId[newState->stateId] = newState;
 }
 
 
 static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, int idIn)
 {
 	cxa_assert(smIn);
+
+	if( (idIn >= 0) && (idIn < CXA_STATE_MACHINE_MAX_NUM_STATES) ) return smIn->states_byId[idIn];
 	
+	// id isn't in our table...search for it
 	for( size_t i = 0; i < cxa_array_getSize_elems(&smIn->states); i++ )
 	{
 		cxa_stateMachine_state_t* currState = (cxa_stateMachine_state_t*)cxa_array_get(&smIn->states, i);
@@ -229,3 +286,17 @@ static cxa_stateMachine_state_t* getState_byId(cxa_stateMachine_t *const smIn, i
 	
 	return NULL;
 }
+
+
+#ifdef CXA_STATE_MACHINE_ENABLE_TIMED_STATES
+static void timerCb_onTimedTransition(cxa_timer_t *const timerIn, void* userVarIn)
+{
+	cxa_stateMachine_t* smIn = (cxa_stateMachine_t*)userVarIn;
+	cxa_assert(smIn);
+
+	// our state's time has expired...transition into our next state
+	// (unless another transition is already pending)
+	if( (smIn->nextState != NULL) || (smIn->currState == NULL) || (smIn->currState->type != CXA_STATE_MACHINE_STATE_TYPE_TIMED) ) return;
+	cxa_stateMachine_transition(smIn, smIn->currState->nextStateId);
+}
+#endif
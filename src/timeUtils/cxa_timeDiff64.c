@@ -0,0 +1,94 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_timeDiff64.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <cxa_assert.h>
+
+
+// ******** local macro definitions ********
+#define NS_PER_MS						1000000ull
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_timeDiff64_init(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	cxa_timeDiff64_setStartTime_now(tdIn);
+}
+
+
+void cxa_timeDiff64_setStartTime_now(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	tdIn->startTime_ns = cxa_timeBase_getCount64_ns();
+}
+
+
+uint64_t cxa_timeDiff64_getElapsedTime_ns(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	return cxa_timeBase_getCount64_ns() - tdIn->startTime_ns;
+}
+
+
+uint64_t cxa_timeDiff64_getElapsedTime_ms(cxa_timeDiff64_t *const tdIn)
+{
+	cxa_assert(tdIn);
+
+	return cxa_timeDiff64_getElapsedTime_ns(tdIn) / NS_PER_MS;
+}
+
+
+bool cxa_timeDiff64_isElapsed_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn)
+{
+	cxa_assert(tdIn);
+
+	return (cxa_timeDiff64_getElapsedTime_ns(tdIn) >= ((uint64_t)msIn * NS_PER_MS));
+}
+
+
+bool cxa_timeDiff64_isElapsed_recurring_ms(cxa_timeDiff64_t *const tdIn, uint32_t msIn)
+{
+	cxa_assert(tdIn);
+
+	uint64_t now_ns = cxa_timeBase_getCount64_ns();
+	bool retVal = ((now_ns - tdIn->startTime_ns) >= ((uint64_t)msIn * NS_PER_MS));
+	if( retVal ) tdIn->startTime_ns = now_ns;
+
+	return retVal;
+}
+
+
+// ******** local function implementations ********
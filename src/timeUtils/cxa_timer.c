@@ -0,0 +1,333 @@
+/**
+ * Copyright 2016 opencxa.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cxa_timer.h"
+
+
+/**
+ * @author Christopher Armenio
+ */
+
+
+// ******** includes ********
+#include <cxa_assert.h>
+#include <cxa_runLoop.h>
+#include <cxa_timeBase.h>
+
+
+// ******** local macro definitions ********
+#if (CXA_TIMER_WHEEL_NUM_LEVELS < 1) || (CXA_TIMER_WHEEL_NUM_LEVELS > 5)
+	#error "CXA_TIMER_WHEEL_NUM_LEVELS must be between 1 and 5"
+#endif
+
+#define SLOT_BITS							CXA_TIMER_WHEEL_SLOT_BITS
+#define NUM_SLOTS							(1 << SLOT_BITS)
+#define SLOT_MASK							(NUM_SLOTS - 1)
+
+// number of ticks (ms) spanned by the entire wheel
+#define WHEEL_SPAN_TICKS					((uint32_t)1 << (SLOT_BITS * CXA_TIMER_WHEEL_NUM_LEVELS))
+
+#define MAX_DELAY_MS						((uint32_t)INT32_MAX)
+
+#define LEVEL_NONE							0xFF
+
+
+// ******** local type definitions ********
+
+
+// ******** local function prototypes ********
+static void syncClock(cxa_timerWheel_t *const wheelIn);
+static void insert(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn);
+static void unlink(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn);
+static void processTick(cxa_timerWheel_t *const wheelIn);
+static void cascade(cxa_timerWheel_t *const wheelIn, uint8_t levelIn, uint8_t slotIn);
+static void expire(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn);
+
+
+// ********  local variable declarations *********
+
+
+// ******** global function implementations ********
+void cxa_timer_init(cxa_timer_t *const timerIn, cxa_timer_cb_onExpire_t cbIn, void* userVarIn)
+{
+	cxa_timer_init_withRunLoop(timerIn, cxa_runLoop_getDefault(), cbIn, userVarIn);
+}
+
+
+void cxa_timer_init_withRunLoop(cxa_timer_t *const timerIn, struct cxa_runLoop *const rlIn, cxa_timer_cb_onExpire_t cbIn, void* userVarIn)
+{
+	cxa_assert(timerIn);
+	cxa_assert(rlIn);
+	cxa_assert(cbIn);
+
+	// save our references
+	timerIn->wheel = cxa_runLoop_instance_getTimerWheel(rlIn);
+	timerIn->next = NULL;
+	timerIn->pprev = NULL;
+	timerIn->level = LEVEL_NONE;
+	timerIn->expiry_ticks = 0;
+	timerIn->period_ms = 0;
+	timerIn->cb = cbIn;
+	timerIn->userVar = userVarIn;
+}
+
+
+void cxa_timer_startOneShot_ms(cxa_timer_t *const timerIn, uint32_t delay_msIn)
+{
+	cxa_assert(timerIn);
+	cxa_assert(delay_msIn <= MAX_DELAY_MS);
+
+	cxa_timer_stop(timerIn);
+	syncClock(timerIn->wheel);
+
+	// we can't expire in the tick that is currently being processed
+	timerIn->expiry_ticks = timerIn->wheel->clockTick + ((delay_msIn > 0) ? delay_msIn : 1);
+	timerIn->period_ms = 0;
+	insert(timerIn->wheel, timerIn);
+}
+
+
+void cxa_timer_startPeriodic_ms(cxa_timer_t *const timerIn, uint32_t period_msIn)
+{
+	cxa_assert(timerIn);
+	cxa_assert((period_msIn > 0) && (period_msIn <= MAX_DELAY_MS));
+
+	cxa_timer_stop(timerIn);
+	syncClock(timerIn->wheel);
+
+	timerIn->expiry_ticks = timerIn->wheel->clockTick + period_msIn;
+	timerIn->period_ms = period_msIn;
+	insert(timerIn->wheel, timerIn);
+}
+
+
+void cxa_timer_stop(cxa_timer_t *const timerIn)
+{
+	cxa_assert(timerIn);
+
+	if( timerIn->pprev != NULL ) unlink(timerIn->wheel, timerIn);
+}
+
+
+bool cxa_timer_isRunning(cxa_timer_t *const timerIn)
+{
+	cxa_assert(timerIn);
+
+	return (timerIn->pprev != NULL);
+}
+
+
+void cxa_timerWheel_init(cxa_timerWheel_t *const wheelIn)
+{
+	cxa_assert(wheelIn);
+
+	for( uint8_t i = 0; i < CXA_TIMER_WHEEL_NUM_LEVELS; i++ )
+	{
+		for( uint8_t j = 0; j < NUM_SLOTS; j++ ) wheelIn->slots[i][j] = NULL;
+		wheelIn->numTimersPerLevel[i] = 0;
+	}
+	wheelIn->numTimers = 0;
+
+	wheelIn->lastCount_us = cxa_timeBase_getCount_us();
+	wheelIn->subTick_us = 0;
+	wheelIn->clockTick = 0;
+	wheelIn->currTick = 0;
+}
+
+
+bool cxa_timerWheel_getTimeUntilNextDeadline_ms(cxa_timerWheel_t *const wheelIn, uint32_t *const time_msOut)
+{
+	cxa_assert(wheelIn);
+	cxa_assert(time_msOut);
+
+	if( wheelIn->numTimers == 0 ) return false;
+	syncClock(wheelIn);
+
+	bool hasDeadline = false;
+	uint32_t nextTick = 0;
+	for( uint8_t i = 0; i < CXA_TIMER_WHEEL_NUM_LEVELS; i++ )
+	{
+		if( wheelIn->numTimersPerLevel[i] == 0 ) continue;
+
+		// the first occupied slot (after the current one) is the next time
+		// this level needs attention (either an expiry or a cascade)
+		uint8_t shift = i * SLOT_BITS;
+		uint32_t currSlot = wheelIn->currTick >> shift;
+		for( uint32_t j = 1; j <= NUM_SLOTS; j++ )
+		{
+			if( wheelIn->slots[i][(currSlot + j) & SLOT_MASK] == NULL ) continue;
+
+			uint32_t candidateTick = (currSlot + j) << shift;
+			if( !hasDeadline || ((int32_t)(candidateTick - nextTick) < 0) ) nextTick = candidateTick;
+			hasDeadline = true;
+			break;
+		}
+	}
+	if( !hasDeadline ) return false;
+
+	int32_t remaining_ms = (int32_t)(nextTick - wheelIn->clockTick);
+	*time_msOut = (remaining_ms > 0) ? (uint32_t)remaining_ms : 0;
+	return true;
+}
+
+
+void cxa_timerWheel_update(cxa_timerWheel_t *const wheelIn)
+{
+	cxa_assert(wheelIn);
+
+	syncClock(wheelIn);
+	while( wheelIn->currTick != wheelIn->clockTick )
+	{
+		if( wheelIn->numTimers == 0 )
+		{
+			wheelIn->currTick = wheelIn->clockTick;
+			break;
+		}
+
+		// find the lowest level with any timers...
+		uint8_t lowestLevel = 0;
+		while( wheelIn->numTimersPerLevel[lowestLevel] == 0 ) lowestLevel++;
+
+		// ...nothing can happen until that level is next cascaded, so skip
+		// the intervening ticks rather than stepping through them one by one
+		if( lowestLevel > 0 )
+		{
+			uint8_t shift = lowestLevel * SLOT_BITS;
+			uint32_t nextCascadeTick = ((wheelIn->currTick >> shift) + 1) << shift;
+			if( (int32_t)(wheelIn->clockTick - nextCascadeTick) < 0 )
+			{
+				wheelIn->currTick = wheelIn->clockTick;
+				break;
+			}
+			wheelIn->currTick = nextCascadeTick;
+		}
+		else wheelIn->currTick++;
+
+		processTick(wheelIn);
+	}
+}
+
+
+// ******** local function implementations ********
+static void syncClock(cxa_timerWheel_t *const wheelIn)
+{
+	uint32_t curr_us = cxa_timeBase_getCount_us();
+	uint32_t elapsed_us = (curr_us >= wheelIn->lastCount_us) ?
+						  (curr_us - wheelIn->lastCount_us) :
+						  ((cxa_timeBase_getMaxCount_us() - wheelIn->lastCount_us) + curr_us);
+	wheelIn->lastCount_us = curr_us;
+
+	wheelIn->clockTick += elapsed_us / 1000;
+	wheelIn->subTick_us += elapsed_us % 1000;
+	if( wheelIn->subTick_us >= 1000 )
+	{
+		wheelIn->clockTick++;
+		wheelIn->subTick_us -= 1000;
+	}
+}
+
+
+static void insert(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn)
+{
+	// timers are placed relative to the last _processed_ tick. Timers
+	// beyond the span of the wheel are placed at its far end and
+	// re-inserted once they get there
+	uint32_t delta = timerIn->expiry_ticks - wheelIn->currTick;
+	if( delta >= WHEEL_SPAN_TICKS ) delta = WHEEL_SPAN_TICKS - 1;
+	uint32_t slotTick = wheelIn->currTick + delta;
+
+	uint8_t level = 0;
+	while( (level < (CXA_TIMER_WHEEL_NUM_LEVELS - 1)) && (delta >= ((uint32_t)1 << ((level + 1) * SLOT_BITS))) ) level++;
+	cxa_timer_t** head = &wheelIn->slots[level][(slotTick >> (level * SLOT_BITS)) & SLOT_MASK];
+
+	// link at the head of the slot
+	timerIn->next = *head;
+	if( timerIn->next != NULL ) timerIn->next->pprev = &timerIn->next;
+	timerIn->pprev = head;
+	*head = timerIn;
+
+	timerIn->level = level;
+	wheelIn->numTimersPerLevel[level]++;
+	wheelIn->numTimers++;
+}
+
+
+static void unlink(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn)
+{
+	*timerIn->pprev = timerIn->next;
+	if( timerIn->next != NULL ) timerIn->next->pprev = timerIn->pprev;
+	timerIn->next = NULL;
+	timerIn->pprev = NULL;
+
+	wheelIn->numTimersPerLevel[timerIn->level]--;
+	wheelIn->numTimers--;
+	timerIn->level = LEVEL_NONE;
+}
+
+
+static void processTick(cxa_timerWheel_t *const wheelIn)
+{
+	uint32_t currTick = wheelIn->currTick;
+
+	// migrate timers down from higher levels whenever we cross their boundary
+	for( uint8_t i = 1; i < CXA_TIMER_WHEEL_NUM_LEVELS; i++ )
+	{
+		uint8_t shift = i * SLOT_BITS;
+		if( (currTick & (((uint32_t)1 << shift) - 1)) != 0 ) break;
+		cascade(wheelIn, i, (currTick >> shift) & SLOT_MASK);
+	}
+
+	// then expire everything in the current slot. The slot is re-read each
+	// time since callbacks may stop other timers in this slot. Re-armed timers
+	// always land in a different slot, so this terminates
+	cxa_timer_t** head = &wheelIn->slots[0][currTick & SLOT_MASK];
+	while( *head != NULL )
+	{
+		cxa_timer_t* currTimer = *head;
+		unlink(wheelIn, currTimer);
+
+		// timers beyond the span of the wheel may need another lap
+		if( currTimer->expiry_ticks != currTick ) insert(wheelIn, currTimer);
+		else expire(wheelIn, currTimer);
+	}
+}
+
+
+static void cascade(cxa_timerWheel_t *const wheelIn, uint8_t levelIn, uint8_t slotIn)
+{
+	cxa_timer_t** head = &wheelIn->slots[levelIn][slotIn];
+	while( *head != NULL )
+	{
+		cxa_timer_t* currTimer = *head;
+		unlink(wheelIn, currTimer);
+		insert(wheelIn, currTimer);
+	}
+}
+
+
+static void expire(cxa_timerWheel_t *const wheelIn, cxa_timer_t *const timerIn)
+{
+	// re-arm periodic timers _before_ the callback (so the callback may stop them)
+	if( timerIn->period_ms > 0 )
+	{
+		// skip any periods we missed (rather than firing repeatedly to catch up)
+		// while staying in phase with the original start time
+		uint32_t late_ms = wheelIn->clockTick - timerIn->expiry_ticks;
+		timerIn->expiry_ticks += ((late_ms / timerIn->period_ms) + 1) * timerIn->period_ms;
+		insert(wheelIn, timerIn);
+	}
+
+	timerIn->cb(timerIn, timerIn->userVar);
+}